@@ -0,0 +1,135 @@
+/***************************************************************************************************************\
+* Chords, i.e., keys that do something else when pressed together.                                              *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/feature_combo (not used, as combos go through the keymap & the tapping term)
+//
+// Chords are checked for as the matrix is scanned, before QMK gets to see the keys. That way a chord fires as
+// soon as its last key goes down, in any order, even if its keys are dual-role keys still waiting on the tapping
+// term. The keys in a chord are then swallowed (unless QMK had already acted on them), so that they don't also
+// type or change layers on their own. Those that QMK is still waiting on (i.e., a dual-role key pressed first) get
+// released right away as far as QMK is concerned, so that they don't stay pending & hold up the keys after them.
+//
+// Nothing is held back waiting to see if a chord is coming, so keys that are not part of one, or are but pressed
+// on their own, behave exactly as before. The flip side is that the keys of a chord need to go down close enough
+// together (CHORD_WINDOW) for it to count, and that anything that close does count: rolling from Space into
+// Enter within CHORD_WINDOW while typing switches to gaming mode instead, with the Space swallowed. So the window
+// is kept short, well under the time between two thumbs when typing (e.g., the roll in sim/traces/chords.trace is
+// 45 ms).
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "layers.h"
+
+// Max time (ms) between the first & last key of a chord.
+#ifndef CHORD_WINDOW
+#    define CHORD_WINDOW 30
+#endif // CHORD_WINDOW
+
+// Each matrix position as a single bit.
+#define CHORD_KEY(row, col) ((uint64_t)1 << ((row)*MATRIX_COLS + (col)))
+
+typedef struct {
+    uint64_t keys;   // Matrix positions, see CHORD_KEY.
+    bool     gaming; // Which mode it's active in.
+    uint8_t  layer;  // Layer to move to.
+} chord_t;
+
+static const chord_t chords[] = {
+    // Both middle thumb keys (Space/L1 & Enter/L2), get into gaming mode.
+    {CHORD_KEY(3, 4) | CHORD_KEY(7, 4), false, G0},
+    // Both outermost thumb keys (MO(G1) & right shift), get back into typing mode.
+    {CHORD_KEY(3, 3) | CHORD_KEY(7, 3), true, T0},
+};
+
+#define CHORDS_COUNT (sizeof(chords) / sizeof(chords[0]))
+
+static matrix_row_t chords_rows[MATRIX_ROWS]; // Matrix as of the last scan.
+static uint64_t     chords_down      = 0;     // Same, as bits.
+static uint64_t     chords_processed = 0;     // Keys down that QMK already acted upon.
+static uint64_t     chords_swallowed = 0;     // Keys that QMK should not see anymore.
+static uint64_t     chords_released  = 0;     // Swallowed keys QMK was told were released (see chords_release).
+static uint16_t     chords_started[CHORDS_COUNT];
+
+// Let QMK know the given keys went up, even though they're still down. The actual releases come later on.
+static void chords_release(uint64_t keys) {
+    chords_released |= keys;
+
+    for (uint8_t i = 0; keys != 0; ++i, keys >>= 1) {
+        if (keys & 1) {
+            action_exec(MAKE_KEYEVENT(i / MATRIX_COLS, i % MATRIX_COLS, false));
+        }
+    }
+}
+
+// Called once per matrix scan, before QMK goes through the changes.
+void chords_scan(void) {
+    uint64_t pressed = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        matrix_row_t bits = matrix_get_row(row);
+        if (bits != chords_rows[row]) {
+            uint64_t delta = (uint64_t)(bits ^ chords_rows[row]) << (row * MATRIX_COLS);
+            chords_down ^= delta;
+            pressed |= delta & chords_down;
+            chords_rows[row] = bits;
+        }
+    }
+    if (pressed == 0) {
+        return;
+    }
+
+    bool gaming = IS_GAMING(layer_state);
+    for (uint8_t i = 0; i < CHORDS_COUNT; ++i) {
+        const chord_t *chord = &chords[i];
+        if (chord->gaming != gaming || !(pressed & chord->keys)) {
+            continue;
+        }
+
+        if ((chords_down & chord->keys) != chord->keys) {
+            chords_started[i] = timer_read(); // Not all there yet.
+        } else if ((pressed & chord->keys) == chord->keys || timer_elapsed(chords_started[i]) <= CHORD_WINDOW) {
+            chords_swallowed |= chord->keys & ~chords_processed;
+            // Down since before this scan, but not acted upon yet: still waiting in QMK's tapping buffer.
+            chords_release(chord->keys & ~pressed & ~chords_processed);
+            layer_move(chord->layer);
+            return;
+        }
+    }
+}
+
+// Called for every key event, returns whether QMK should go on with it.
+bool chords_record(keyrecord_t *record) {
+    uint64_t key = CHORD_KEY(record->event.key.row, record->event.key.col);
+
+    if (chords_swallowed & key) {
+        if (record->event.pressed) {
+            // Still swallowed.
+        } else if (chords_released & key) {
+            chords_released &= ~key; // The made up release, the actual one is yet to come.
+        } else {
+            chords_swallowed &= ~key;
+        }
+        return false;
+    }
+
+    if (record->event.pressed) {
+        chords_processed |= key;
+    } else {
+        chords_processed &= ~key;
+    }
+    return true;
+}
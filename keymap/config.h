@@ -22,6 +22,26 @@
 
 #define MASTER_LEFT
 
+//////////////////////////////////////////////////// Split //////////////////////////////////////////////////////
+// https://docs.qmk.fm/#/feature_split_keyboard?id=data-sync-options
+
+// Both halves need to know the mode to debounce the same way (see debounce.c).
+#define SPLIT_LAYER_STATE_ENABLE
+
+// Whatever didn't change is still synced every so often, though less often while idle (see idle.h).
+//
+// QMK has no way to change that at runtime, so FORCED_SYNC_THROTTLE_MS is pointed at a variable rather than a
+// number. That relies on QMK only using it as a value compared against the elapsed time, which it does in a single
+// place (quantum/split_common/transactions.c). Check that's still the case after updating QMK: in an #if it would
+// silently count as 0, and in an initialiser it would fail to build. This file is also included into assembly
+// sources, which get none of it.
+#define IDLE_SYNC_THROTTLE_AWAKE 100 // QMK's default.
+#ifndef __ASSEMBLER__
+#    include <stdint.h>
+extern uint16_t idle_sync_throttle;
+#    define FORCED_SYNC_THROTTLE_MS idle_sync_throttle
+#endif // __ASSEMBLER__
+
 ////////////////////////////////////////////////////// RGB //////////////////////////////////////////////////////
 // https://docs.qmk.fm/#/feature_rgb_matrix
 // https://github.com/qmk/qmk_firmware/tree/master/quantum/rgb_matrix_animations/
@@ -50,17 +70,18 @@
 // React to keypresses.
 #    define RGB_MATRIX_KEYPRESSES
 #    define RGB_MATRIX_KEYRELEASES
+// Enough to fit fast typing within the time it takes a key to fade out (see rgb_matrix_user.inc).
+#    define LED_HITS_TO_REMEMBER 16
 
-// Light up pressed key momentarily.
-#    define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
-
-// Simple solid colour lighting.
-#    define ENABLE_RGB_MATRIX_SOLID_COLOR
+// Lighting up pressed keys momentarily & simple solid colour lighting are both custom effects instead, which only
+// draw what changes (see rgb_render.h).
 
 #endif // RGB_MATRIX_ENABLE
 
 //////////////////////////////////////////////////// Others /////////////////////////////////////////////////////
 
 #define TAPPING_TERM 150
+// Adapt the tapping term of each dual-role key to how it's being tapped (see tapping.h).
+#define TAPPING_TERM_PER_KEY
 
 #define PERMISSIVE_HOLD
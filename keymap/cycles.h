@@ -0,0 +1,168 @@
+/***************************************************************************************************************\
+* Cycle counters for the main loop, the keymap hooks and the RGB matrix.                                        *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/faq_debug
+//
+// Only built with `CYCLES_ENABLE = yes` (see rules.mk). Timer 1 is left unused on this board, so it is set to
+// count every CPU cycle. Every few seconds the following is printed to the console (`qmk console`), as mean/max:
+//  * Cycles per pass of the main loop when the RGB matrix did not render (i.e., pretty much just the scan).
+//  * Cycles per pass of the main loop when the RGB matrix rendered a slice of LEDs.
+//  * Cycles per call to process_record_user.
+//  * Cycles per full RGB frame, adding up all of its rendering passes. Each pass is counted from when the custom
+//    effect starts drawing (see rgb_render.h), or from the start of the loop without custom effects.
+//  * LEDs written per full RGB frame by the custom effects & indicators (see rgb_render.h).
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#ifdef CYCLES_ENABLE
+
+#    include <avr/interrupt.h>
+#    include "print.h"
+#    include "rgb_render.h"
+
+#    define CYCLES_REPORT_INTERVAL 5000
+
+typedef struct {
+    uint16_t count;
+    uint32_t total;
+    uint32_t max;
+} cycles_stat_t;
+
+static cycles_stat_t cycles_scan;
+static cycles_stat_t cycles_render;
+static cycles_stat_t cycles_record;
+static cycles_stat_t cycles_frame;
+static cycles_stat_t cycles_leds;
+
+static volatile uint16_t cycles_overflows = 0;
+static uint32_t          cycles_loop_start;
+static uint32_t          cycles_record_start;
+static uint32_t          cycles_rgb_start;
+static uint32_t          cycles_frame_total;
+static bool              cycles_rendered = false;
+static uint16_t          cycles_timer;
+
+ISR(TIMER1_OVF_vect) {
+    ++cycles_overflows;
+}
+
+static uint32_t cycles_read(void) {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t low  = TCNT1;
+    uint16_t high = cycles_overflows;
+    if ((TIFR1 & _BV(TOV1)) && low < 0x8000) {
+        ++high; // Overflowed, but the interrupt did not get to run yet.
+    }
+    SREG = sreg;
+
+    return ((uint32_t)high << 16) | low;
+}
+
+static void cycles_add(cycles_stat_t *stat, uint32_t cycles) {
+    if (stat->count == UINT16_MAX) {
+        return;
+    }
+
+    ++stat->count;
+    stat->total += cycles;
+    if (cycles > stat->max) {
+        stat->max = cycles;
+    }
+}
+
+static void cycles_print(const char *name, cycles_stat_t *stat) {
+    uprintf(" %s %lu/%lu", name, stat->count ? stat->total / stat->count : 0, stat->max);
+    *stat = (cycles_stat_t){0};
+}
+
+void cycles_init(void) {
+    TCCR1A = 0x00;
+    TCCR1B = _BV(CS10); // No prescaler, 1 tick per cycle.
+    TIMSK1 = _BV(TOIE1);
+
+    cycles_loop_start = cycles_read();
+    cycles_rgb_start  = cycles_loop_start;
+    cycles_timer      = timer_read();
+}
+
+// Called once per pass of the main loop.
+void cycles_task(void) {
+    uint32_t now = cycles_read();
+    cycles_add(cycles_rendered ? &cycles_render : &cycles_scan, now - cycles_loop_start);
+    cycles_rendered   = false;
+    cycles_loop_start = now;
+    cycles_rgb_start  = now;
+
+    if (timer_elapsed(cycles_timer) >= CYCLES_REPORT_INTERVAL) {
+        cycles_timer = timer_read();
+
+        uprintf("cycles:");
+        cycles_print("scan", &cycles_scan);
+        cycles_print("scan+rgb", &cycles_render);
+        cycles_print("record", &cycles_record);
+        cycles_print("frame", &cycles_frame);
+        cycles_print("leds", &cycles_leds);
+        uprintf("\n");
+
+        cycles_loop_start = cycles_read(); // Don't count the printing.
+        cycles_rgb_start  = cycles_loop_start;
+    }
+}
+
+void cycles_record_begin(void) {
+    cycles_record_start = cycles_read();
+}
+
+void cycles_record_end(void) {
+    cycles_add(&cycles_record, cycles_read() - cycles_record_start);
+}
+
+// Called right before a custom effect renders each slice of LEDs.
+void cycles_rgb_begin(void) {
+    cycles_rgb_start = cycles_read();
+}
+
+// Called after each slice of LEDs is rendered, led_min being 0 for the first slice of every frame.
+void cycles_rgb(uint8_t led_min, uint8_t led_max) {
+    uint32_t now = cycles_read();
+    if (led_min == 0) {
+        cycles_frame_total = 0;
+    }
+    cycles_frame_total += now - cycles_rgb_start;
+    if (led_max == DRIVER_LED_TOTAL) {
+        cycles_add(&cycles_frame, cycles_frame_total);
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_CUSTOM_USER)
+        cycles_add(&cycles_leds, rgb_render_touched);
+        rgb_render_touched = 0;
+#    endif // RGB_MATRIX_ENABLE && RGB_MATRIX_CUSTOM_USER
+    }
+
+    cycles_rendered = true;
+}
+
+#else // CYCLES_ENABLE
+
+static inline void cycles_init(void) {}
+static inline void cycles_task(void) {}
+static inline void cycles_record_begin(void) {}
+static inline void cycles_record_end(void) {}
+static inline void cycles_rgb(uint8_t led_min, uint8_t led_max) {}
+
+#endif // CYCLES_ENABLE
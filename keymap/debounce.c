@@ -0,0 +1,111 @@
+/***************************************************************************************************************\
+* Debounce algorithm that depends on the current mode.                                                          *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/feature_debounce_type
+//
+// While typing, this is the same as QMK's default (sym_defer_g): changes are only let through once the whole
+// matrix has been quiet for DEBOUNCE ms, which is the most forgiving with noisy switches.
+//
+// While gaming, it switches to sym_eager_pk: every change goes through as soon as it's seen, and then that key
+// alone ignores further changes for DEBOUNCE ms. This saves the DEBOUNCE ms on every key press.
+//
+// The mode is read from the layer state, which is also synced to the other half (SPLIT_LAYER_STATE_ENABLE) so
+// that both debounce the same way.
+
+#include QMK_KEYBOARD_H
+#include "debounce.h"
+
+#include "layers.h"
+#include "trace.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif // DEBOUNCE
+
+static bool     debounce_eager = false;
+static uint16_t debounce_timer;
+
+// Typing.
+static bool debouncing = false;
+
+// Gaming.
+static uint8_t  debounce_counters[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t debounce_last;
+
+void debounce_init(uint8_t num_rows) {
+    debounce_last = timer_read();
+}
+
+void debounce_free(void) {}
+
+static void debounce_defer(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    if (changed) {
+        debouncing     = true;
+        debounce_timer = timer_read();
+
+    } else if (debouncing && timer_elapsed(debounce_timer) >= DEBOUNCE) {
+        for (uint8_t row = 0; row < num_rows; ++row) {
+            cooked[row] = raw[row];
+        }
+        debouncing = false;
+    }
+}
+
+static void debounce_eager_pk(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed) {
+    for (uint8_t row = 0; row < num_rows; ++row) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+            uint8_t *counter = &debounce_counters[row][col];
+            if (*counter > 0) {
+                *counter = elapsed < *counter ? *counter - elapsed : 0;
+                if (*counter > 0) {
+                    continue;
+                }
+            }
+
+            if (delta & ((matrix_row_t)1 << col)) {
+                cooked[row] ^= (matrix_row_t)1 << col;
+                *counter = DEBOUNCE;
+            }
+        }
+    }
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    uint16_t now     = timer_read();
+    uint16_t elapsed = TIMER_DIFF_16(now, debounce_last);
+    debounce_last    = now;
+
+    if (changed) {
+        trace_matrix(raw, num_rows);
+    }
+
+    bool eager = IS_GAMING(layer_state);
+    if (eager != debounce_eager) {
+        debounce_eager = eager;
+
+        // Whatever was left pending gets settled by the typing algorithm once the matrix is quiet.
+        debouncing     = true;
+        debounce_timer = now;
+    }
+
+    if (eager) {
+        debounce_eager_pk(raw, cooked, num_rows, elapsed < UINT8_MAX ? elapsed : UINT8_MAX);
+    } else {
+        debounce_defer(raw, cooked, num_rows, changed);
+    }
+}
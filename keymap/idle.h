@@ -0,0 +1,140 @@
+/***************************************************************************************************************\
+* Lighting & split syncing that wind down while the keyboard is left alone.                                     *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/feature_rgb_matrix
+// https://docs.qmk.fm/#/feature_split_keyboard?id=data-sync-options
+//
+// The longer it goes without any key event, the more gets wound down, in tiers:
+//  - Dim: the lighting goes down to IDLE_BRIGHTNESS.
+//  - Dark: the lighting is turned off, so no more frames get rendered (on either half, as it's synced over).
+//  - Relaxed: what didn't change is only synced to the other half every IDLE_SYNC_THROTTLE ms, instead of every
+//    FORCED_SYNC_THROTTLE_MS (see config.h). Whatever does change still goes through on the next pass.
+// How long it takes to get into each one depends on the mode. While gaming the keyboard sits untouched for a while
+// when only the mouse is in use, so the lighting stays on for longer.
+//
+// Any key event wakes everything back up. None of it gets in the way of the key itself: the matrix is scanned the
+// same no matter the tier, and waking up only flips back a few settings, so the lighting catches up on the next
+// frame while the key goes through as usual.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#include "modes.h"
+#include "rgb_macros.h"
+
+// Seconds without key events until each tier, 0 to never get into it.
+#ifndef IDLE_TYPING_DIM
+#    define IDLE_TYPING_DIM 30
+#endif // IDLE_TYPING_DIM
+#ifndef IDLE_TYPING_DARK
+#    define IDLE_TYPING_DARK 120
+#endif // IDLE_TYPING_DARK
+#ifndef IDLE_TYPING_RELAXED
+#    define IDLE_TYPING_RELAXED 300
+#endif // IDLE_TYPING_RELAXED
+
+#ifndef IDLE_GAMING_DIM
+#    define IDLE_GAMING_DIM 300
+#endif // IDLE_GAMING_DIM
+#ifndef IDLE_GAMING_DARK
+#    define IDLE_GAMING_DARK 900
+#endif // IDLE_GAMING_DARK
+#ifndef IDLE_GAMING_RELAXED
+#    define IDLE_GAMING_RELAXED 900
+#endif // IDLE_GAMING_RELAXED
+
+#ifndef IDLE_BRIGHTNESS
+#    define IDLE_BRIGHTNESS (RGB_MATRIX_MAXIMUM_BRIGHTNESS / 4)
+#endif // IDLE_BRIGHTNESS
+
+#ifndef IDLE_SYNC_THROTTLE
+#    define IDLE_SYNC_THROTTLE 1000
+#endif // IDLE_SYNC_THROTTLE
+
+enum {
+    IDLE_DIM,
+    IDLE_DARK,
+    IDLE_RELAXED,
+    IDLE_TIERS,
+};
+
+// Indexed by mode_gaming.
+static const uint32_t idle_timeouts[2][IDLE_TIERS] PROGMEM = {
+    [false] = {IDLE_TYPING_DIM * 1000UL, IDLE_TYPING_DARK * 1000UL, IDLE_TYPING_RELAXED * 1000UL},
+    [true]  = {IDLE_GAMING_DIM * 1000UL, IDLE_GAMING_DARK * 1000UL, IDLE_GAMING_RELAXED * 1000UL},
+};
+
+// Read by QMK's split transactions, through FORCED_SYNC_THROTTLE_MS.
+uint16_t idle_sync_throttle = IDLE_SYNC_THROTTLE_AWAKE;
+
+static uint8_t  idle_tiers = 0; // One bit per tier that's in effect.
+static uint32_t idle_timer;     // Last key event.
+
+static void idle_apply(uint8_t tiers) {
+    uint8_t changed = tiers ^ idle_tiers;
+    idle_tiers      = tiers;
+
+#ifdef RGB_MATRIX_ENABLE
+    if (changed & (1 << IDLE_DIM)) {
+        rgb_set_brightness(tiers & (1 << IDLE_DIM) ? IDLE_BRIGHTNESS : 0xFF);
+    }
+    if (changed & (1 << IDLE_DARK)) {
+        if (tiers & (1 << IDLE_DARK)) {
+            rgblight_disable_noeeprom();
+        } else {
+            rgblight_enable_noeeprom();
+        }
+    }
+#endif // RGB_MATRIX_ENABLE
+    if (changed & (1 << IDLE_RELAXED)) {
+        idle_sync_throttle = tiers & (1 << IDLE_RELAXED) ? IDLE_SYNC_THROTTLE : IDLE_SYNC_THROTTLE_AWAKE;
+    }
+}
+
+void idle_init(void) {
+    idle_timer = timer_read32();
+}
+
+// Called on every key event, before anything else gets to see it.
+void idle_record(void) {
+    idle_timer = timer_read32();
+    if (idle_tiers != 0) {
+        idle_apply(0);
+    }
+}
+
+// Called once per pass of the main loop.
+void idle_task(void) {
+    // The other half doesn't see any key events, & gets the lighting synced over anyway.
+    if (!is_keyboard_master() || idle_tiers == (1 << IDLE_TIERS) - 1) {
+        return;
+    }
+
+    uint32_t elapsed = timer_elapsed32(idle_timer);
+    uint8_t  tiers   = 0;
+    for (uint8_t tier = 0; tier < IDLE_TIERS; ++tier) {
+        uint32_t timeout = pgm_read_dword(&idle_timeouts[mode_gaming][tier]);
+        if (timeout != 0 && elapsed >= timeout) {
+            tiers |= 1 << tier;
+        }
+    }
+
+    if (tiers != idle_tiers) {
+        idle_apply(tiers);
+    }
+}
@@ -0,0 +1,190 @@
+/***************************************************************************************************************\
+* Per layer LED indicators, drawn on top of the current effect.                                                 *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/feature_rgb_matrix?id=indicators
+//
+// Each layer has a table with a palette colour for every LED, laid out like the keymap, highlighting the keys that
+// do something in it (plus the underglow, which shows the mode). Both tables and palette live in flash and are
+// already in LED order & RGB, so drawing them is a straight copy for the LEDs in the current frame's slice.
+//
+// The tables are written by hand, but `make -C sim check` makes sure they still match the keymap (see
+// sim/indicators.c). Define INDICATORS_TABLES to get just those (and the palette), without the drawing.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "layers.h"
+#include "rgb_render.h"
+
+#ifdef RGB_MATRIX_ENABLE
+
+///////////////////////////////////////////////////// Palette ///////////////////////////////////////////////////
+
+enum {
+    ___ = 0, // Leave the effect be.
+    KEY,     // Other keys.
+    FUN,     // Function keys.
+    NUM,     // Numbers.
+    SYM,     // Symbols & operators.
+    NAV,     // Navigation.
+    EDT,     // Editing.
+    MED,     // Media & lighting.
+    MOD,     // Mode switch.
+    GAM,     // Gaming mode.
+};
+
+// Kept under RGB_MATRIX_MAXIMUM_BRIGHTNESS.
+static const RGB indicators_palette[] PROGMEM = {
+    [KEY] = {.r = 0x50, .g = 0x50, .b = 0x50},
+    [FUN] = {.r = 0x00, .g = 0x30, .b = 0x8C},
+    [NUM] = {.r = 0x00, .g = 0x8C, .b = 0x20},
+    [SYM] = {.r = 0x60, .g = 0x00, .b = 0x8C},
+    [NAV] = {.r = 0x8C, .g = 0x60, .b = 0x00},
+    [EDT] = {.r = 0x8C, .g = 0x28, .b = 0x00},
+    [MED] = {.r = 0x00, .g = 0x70, .b = 0x70},
+    [MOD] = {.r = 0x8C, .g = 0x00, .b = 0x50},
+    [GAM] = {.r = 0x8C, .g = 0x00, .b = 0x00},
+};
+
+////////////////////////////////////////////////////// Tables ///////////////////////////////////////////////////
+
+// Same as LAYOUT_split_3x6_3, but in LED order & with a colour for the underglow.
+// clang-format off
+#define LEDS_split_3x6_3(                                                                                       \
+    U,                                                                                                          \
+    L00, L01, L02, L03, L04, L05, R00, R01, R02, R03, R04, R05,                                                 \
+    L10, L11, L12, L13, L14, L15, R10, R11, R12, R13, R14, R15,                                                 \
+    L20, L21, L22, L23, L24, L25, R20, R21, R22, R23, R24, R25,                                                 \
+                   L30, L31, L32, R30, R31, R32                                                                 \
+)                                                                                                               \
+{                                                                                                               \
+    U,   U,   U,   U,   U,   U,   L32, L25, L15,                                                                \
+    L05, L04, L14, L24, L31, L30, L23, L13, L03,                                                                \
+    L02, L12, L22, L21, L11, L01, L00, L10, L20,                                                                \
+    U,   U,   U,   U,   U,   U,   R30, R20, R10,                                                                \
+    R00, R01, R11, R21, R31, R32, R22, R12, R02,                                                                \
+    R03, R13, R23, R24, R14, R04, R05, R15, R25,                                                                \
+}
+
+static const uint8_t indicators[][DRIVER_LED_TOTAL] PROGMEM = {
+
+    [TYPING_0] = LEDS_split_3x6_3(___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    ___,     ___,     ___,     ___,     ___,     ___,      ___,     ___,     ___,     ___,     ___,     ___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    ___,     ___,     ___,     ___,     ___,     ___,      ___,     ___,     ___,     ___,     ___,     ___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    ___,     ___,     ___,     ___,     ___,     ___,      ___,     ___,     ___,     ___,     ___,     ___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+                               ___,     ___,     ___,      ___,     ___,     ___
+//                            +--------+--------+--------++--------+--------+--------+
+    ),
+
+    [TYPING_1] = LEDS_split_3x6_3(___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    FUN,     FUN,     FUN,     FUN,     EDT,     EDT,      SYM,     NUM,     NUM,     NUM,     SYM,     SYM,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    FUN,     FUN,     FUN,     FUN,     NAV,     NAV,      SYM,     NUM,     NUM,     NUM,     SYM,     SYM,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    FUN,     FUN,     FUN,     FUN,     NAV,     NAV,      NUM,     NUM,     NUM,     NUM,     SYM,     EDT,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+                               ___,     ___,     ___,      ___,     MOD,     ___
+//                            +--------+--------+--------++--------+--------+--------+
+    ),
+
+    [TYPING_2] = LEDS_split_3x6_3(___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    NUM,     NUM,     NUM,     NUM,     NUM,     SYM,      MED,     MED,     MED,     MED,     MED,     EDT,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    NUM,     NUM,     NUM,     NUM,     NUM,     SYM,      NAV,     NAV,     NAV,     NAV,     MED,     MED,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    EDT,     EDT,     EDT,     SYM,     SYM,     SYM,      MED,     MED,     EDT,     EDT,     MED,     MED,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+                               ___,     MOD,     ___,      EDT,     ___,     EDT
+//                            +--------+--------+--------++--------+--------+--------+
+    ),
+
+    [GAMING_0] = LEDS_split_3x6_3(GAM,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    ___,     ___,     ___,     GAM,     ___,     ___,      ___,     ___,     ___,     ___,     ___,     ___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    ___,     ___,     GAM,     GAM,     GAM,     ___,      ___,     ___,     ___,     ___,     ___,     ___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    ___,     ___,     ___,     ___,     ___,     ___,      ___,     ___,     ___,     ___,     ___,     ___,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+                               ___,     ___,     ___,      ___,     ___,     ___
+//                            +--------+--------+--------++--------+--------+--------+
+    ),
+
+    [GAMING_1] = LEDS_split_3x6_3(GAM,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    ___,     ___,     KEY,     ___,     KEY,     KEY,      FUN,     FUN,     FUN,     FUN,     FUN,     FUN,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    KEY,     ___,     ___,     ___,     ___,     KEY,      NAV,     NAV,     NAV,     NAV,     NAV,     NAV,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+    KEY,     ___,     KEY,     KEY,     KEY,     KEY,      FUN,     FUN,     FUN,     FUN,     FUN,     FUN,
+// +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
+                               ___,     ___,     ___,      ___,     ___,     MOD
+//                            +--------+--------+--------++--------+--------+--------+
+    ),
+};
+// clang-format on
+
+#    ifndef INDICATORS_TABLES
+
+///////////////////////////////////////////////////// Drawing ///////////////////////////////////////////////////
+
+static uint8_t indicators_layer = TYPING_0;
+
+void indicators_render(uint8_t led_min, uint8_t led_max) {
+    // Looked up on every slice rather than when the layer changes, as the other half only gets the layers synced
+    // over (layer_state_set_user is never called on it).
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    if (layer != indicators_layer) {
+        indicators_layer = layer;
+        rgb_render_invalidate();
+    }
+
+    if (!rgb_render_drawn(led_max)) {
+        return; // Still on the LEDs from the last time.
+    }
+
+    // Dimmed along with the effect (see idle.h).
+    uint8_t value = rgb_matrix_config.hsv.v;
+    bool    dim   = value < RGB_MATRIX_MAXIMUM_BRIGHTNESS;
+
+    const uint8_t *table = indicators[indicators_layer];
+    for (uint8_t i = led_min; i < led_max; ++i) {
+        uint8_t colour = pgm_read_byte(&table[i]);
+        if (colour == ___) {
+            continue;
+        }
+
+        const RGB *palette = &indicators_palette[colour];
+        RGB        rgb     = {pgm_read_byte(&palette->r), pgm_read_byte(&palette->g), pgm_read_byte(&palette->b)};
+        if (dim) {
+            rgb.r = (uint16_t)rgb.r * value / RGB_MATRIX_MAXIMUM_BRIGHTNESS;
+            rgb.g = (uint16_t)rgb.g * value / RGB_MATRIX_MAXIMUM_BRIGHTNESS;
+            rgb.b = (uint16_t)rgb.b * value / RGB_MATRIX_MAXIMUM_BRIGHTNESS;
+        }
+        rgb_render_set(i, rgb.r, rgb.g, rgb.b);
+    }
+}
+
+#    endif // INDICATORS_TABLES
+
+#endif // RGB_MATRIX_ENABLE
@@ -20,9 +20,17 @@
 
 #include QMK_KEYBOARD_H
 
+#include "chords.h"
+#include "cycles.h"
+#include "idle.h"
+#include "indicators.h"
 #include "layers.h"
 #include "macros.h"
+#include "modes.h"
 #include "rgb_macros.h"
+#include "state.h"
+#include "tapping.h"
+#include "trace.h"
 
 // clang-format off
 const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS] PROGMEM = {
@@ -71,7 +79,7 @@ const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS] PROGMEM = {
 // +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
     KC_CUT,  KC_COPY, KC_PSTE, KC_LBRC, KC_RBRC, KC_EQL,   KC_RGBM, KC_RGBC, KC_UNDO, KC_AGIN, KC_MUTE, KC_BRID,
 // +--------+--------+--------+--------+--------+--------++--------+--------+--------+--------+--------+--------+
-                               KC_TRNS, TO(G0),  KC_TRNS,  KC_TRNS, KC_TRNS, KC_TRNS
+                               KC_TRNS, TO(G0),  KC_TRNS,  KC_SIGN, KC_TRNS, KC_GPL
 //                            +--------+--------+--------++--------+--------+--------+
     ),
 
@@ -111,10 +119,72 @@ const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS] PROGMEM = {
 };
 // clang-format on
 
+#ifdef FLAT_KEYMAP_ENABLE
+#    include "keymap_flat.h"
+
+// Same keymap, but with every layer already resolved over the ones below it, so the top active layer always has
+// the key & looking it up never walks down through the transparent ones.
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (layer >= sizeof(keymaps_flat) / sizeof(keymaps_flat[0]) || key.row >= MATRIX_ROWS ||
+        key.col >= MATRIX_COLS) {
+        return KC_NO;
+    }
+
+    return pgm_read_word(&keymaps_flat[layer][key.row][key.col]);
+}
+#endif // FLAT_KEYMAP_ENABLE
+
 void keyboard_post_init_user(void) {
+    cycles_init();  // Start counting (if enabled).
+    idle_init();    // Start counting the time without key events.
+    tapping_init(); // Start from the default tapping term.
+
+#ifdef RGB_MATRIX_ENABLE
     rgblight_enable_noeeprom(); // Enable LEDs.
-    rgb_next_colour();          // Set colour
-    rgb_next_mode();            // Set effect.
+#endif // RGB_MATRIX_ENABLE
+
+    state_restore(); // Back to the last mode, colour, effect & speed.
+}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    trace_record_begin(keycode, record);
+    idle_record();
+
+    // Keys from a chord that fired go no further, & nothing custom while gaming (leave it all to QMK), other than
+    // holding keys back until a snippet that was already playing is done.
+    bool result = chords_record(record);
+    if (result && !mode_gaming) {
+        cycles_record_begin();
+        tapping_record(keycode, record);
+        result = process_record_macros(keycode, record);
+        cycles_record_end();
+    } else if (result) {
+        result = process_record_snippets(keycode, record);
+    }
+
+    trace_record_end(record);
+    return result;
+}
+
+layer_state_t layer_state_set_user(layer_state_t state) {
+    return mode_update(state);
+}
+
+void matrix_scan_user(void) {
+    chords_scan();
+}
+
+void housekeeping_task_user(void) {
+    idle_task();
+    snippets_task();
+    state_task();
+    trace_task();
+    cycles_task();
+}
 
-    rgblight_set_speed_noeeprom(0x40); // Set speed (~1.5s).
+#ifdef RGB_MATRIX_ENABLE
+void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    indicators_render(led_min, led_max);
+    cycles_rgb(led_min, led_max);
 }
+#endif // RGB_MATRIX_ENABLE
@@ -0,0 +1,77 @@
+/***************************************************************************************************************\
+* Flattened keymap, GENERATED by sim/flatten.c from keymaps[] (see keymap.c).                                   *
+* Don't edit by hand, run `make -C sim flat` after changing the keymap instead.                                 *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+#pragma once
+
+// Every layer as seen when it's the top one, i.e., with its transparent keys already resolved over the layers
+// it's stacked on. Indexed the same as keymaps[], & included right after it.
+
+// clang-format off
+static const uint16_t keymaps_flat[][MATRIX_ROWS][MATRIX_COLS] PROGMEM = {
+    [TYPING_0] = {
+        {KC_TAB,        KC_Q,          KC_W,          KC_E,          KC_R,          KC_T},
+        {KC_ESC,        KC_A,          KC_S,          KC_D,          KC_F,          KC_G},
+        {KC_APP,        KC_Z,          KC_X,          KC_C,          KC_V,          KC_B},
+        {KC_NO,         KC_NO,         KC_NO,         KC_LSFT,       LT(T1,KC_SPC), KC_LALT},
+        {KC_BSDL,       KC_P,          KC_O,          KC_I,          KC_U,          KC_Y},
+        {KC_QUOT,       KC_SCLN,       KC_L,          KC_K,          KC_J,          KC_H},
+        {KC_BSLS,       KC_SLSH,       KC_DOT,        KC_COMM,       KC_M,          KC_N},
+        {KC_NO,         KC_NO,         KC_NO,         KC_LCTL,       LT(T2,KC_ENT), KC_LGUI},
+    },
+    [TYPING_1] = {
+        {KC_F1,         KC_F4,         KC_F7,         KC_F10,        KC_PSCR,       KC_INS},
+        {KC_F2,         KC_F5,         KC_F8,         KC_F11,        KC_HOME,       KC_PGUP},
+        {KC_F3,         KC_F6,         KC_F9,         KC_F12,        KC_END,        KC_PGDN},
+        {KC_NO,         KC_NO,         KC_NO,         KC_LSFT,       LT(T1,KC_SPC), KC_LALT},
+        {KC_PSLS,       KC_PMNS,       KC_P9,         KC_P8,         KC_P7,         KC_NLCK},
+        {KC_PAST,       KC_PPLS,       KC_P6,         KC_P5,         KC_P4,         KC_PDOT},
+        {KC_BSES,       KC_PENT,       KC_P3,         KC_P2,         KC_P1,         KC_P0},
+        {KC_NO,         KC_NO,         KC_NO,         KC_LCTL,       TO(G0),        KC_LGUI},
+    },
+    [TYPING_2] = {
+        {KC_1,          KC_2,          KC_3,          KC_4,          KC_5,          KC_GRV},
+        {KC_6,          KC_7,          KC_8,          KC_9,          KC_0,          KC_MINS},
+        {KC_CUT,        KC_COPY,       KC_PSTE,       KC_LBRC,       KC_RBRC,       KC_EQL},
+        {KC_NO,         KC_NO,         KC_NO,         KC_LSFT,       TO(G0),        KC_LALT},
+        {KC_CAPS,       KC_MSTP,       KC_MNXT,       KC_VOLU,       KC_VOLD,       KC_MPRV},
+        {KC_BRIU,       KC_MPLY,       KC_RGHT,       KC_UP,         KC_DOWN,       KC_LEFT},
+        {KC_BRID,       KC_MUTE,       KC_AGIN,       KC_UNDO,       KC_RGBC,       KC_RGBM},
+        {KC_NO,         KC_NO,         KC_NO,         KC_GPL,        LT(T2,KC_ENT), KC_SIGN},
+    },
+    [GAMING_0] = {
+        {KC_ESC,        KC_TAB,        KC_Q,          KC_W,          KC_E,          KC_R},
+        {KC_J,          KC_LSFT,       KC_A,          KC_S,          KC_D,          KC_F},
+        {KC_M,          KC_LCTL,       KC_Z,          KC_X,          KC_C,          KC_V},
+        {KC_NO,         KC_NO,         KC_NO,         MO(G1),        KC_LALT,       KC_SPC},
+        {KC_PGUP,       KC_5,          KC_4,          KC_3,          KC_2,          KC_1},
+        {KC_PGDN,       KC_0,          KC_9,          KC_8,          KC_7,          KC_6},
+        {KC_BSLS,       KC_SLSH,       KC_SCLN,       KC_DOT,        KC_COMM,       KC_MINS},
+        {KC_NO,         KC_NO,         KC_NO,         KC_RSFT,       KC_RALT,       KC_ENT},
+    },
+    [GAMING_1] = {
+        {KC_ESC,        KC_TAB,        KC_L,          KC_W,          KC_T,          KC_O},
+        {KC_P,          KC_LSFT,       KC_A,          KC_S,          KC_D,          KC_G},
+        {KC_I,          KC_LCTL,       KC_B,          KC_N,          KC_H,          KC_K},
+        {KC_NO,         KC_NO,         KC_NO,         MO(G1),        KC_LALT,       KC_SPC},
+        {KC_F6,         KC_F5,         KC_F4,         KC_F3,         KC_F2,         KC_F1},
+        {KC_END,        KC_HOME,       KC_RGHT,       KC_UP,         KC_DOWN,       KC_LEFT},
+        {KC_F12,        KC_F11,        KC_F10,        KC_F9,         KC_F8,         KC_F7},
+        {KC_NO,         KC_NO,         KC_NO,         TO(T0),        KC_RALT,       KC_ENT},
+    },
+};
+// clang-format on
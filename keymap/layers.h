@@ -41,3 +41,10 @@ enum {
     G0 = GAMING_0,
     G1 = GAMING_1,
 };
+
+////////////////////////////////////////////////////// Modes ////////////////////////////////////////////////////
+
+#define TYPING_LAYERS ((1UL << TYPING_0) | (1UL << TYPING_1) | (1UL << TYPING_2))
+#define GAMING_LAYERS ((1UL << GAMING_0) | (1UL << GAMING_1))
+
+#define IS_GAMING(state) (((state)&GAMING_LAYERS) != 0)
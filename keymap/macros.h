@@ -21,16 +21,27 @@
 
 #include QMK_KEYBOARD_H
 #include "rgb_macros.h"
+#include "snippets.h"
+#include "snippets_packed.h"
 
 ////////////////////////////////////////////// Macro declarations ///////////////////////////////////////////////
 
 enum {
+    // Mod-morphs, these need to come first (see morphs).
     BACKSPACE_DELETE = SAFE_RANGE,
     BACKSPACE_ESCAPE,
-    RGB_MODE,
+    MORPHS_END,
+
+    RGB_MODE = MORPHS_END,
     RGB_COLOUR,
+
+    // Snippets, one per entry in snippets.h.
+    SNIPPETS_START,
+    SNIPPETS_END = SNIPPETS_START + SNIPPETS_COUNT,
 };
 
+#define MORPHS_COUNT (MORPHS_END - SAFE_RANGE)
+
 //////////////////////////////////////////////////// Aliases ////////////////////////////////////////////////////
 // Easier to put in the keymap
 
@@ -39,35 +50,249 @@ enum {
     KC_BSES = BACKSPACE_ESCAPE,
     KC_RGBM = RGB_MODE,
     KC_RGBC = RGB_COLOUR,
+    KC_SIGN = SNIPPETS_START + SNIPPET_SIGNATURE,
+    KC_GPL  = SNIPPETS_START + SNIPPET_LICENCE,
 };
 
 /////////////////////////////////////////////// Macro definitions ///////////////////////////////////////////////
 
-void custom_modifier(keyrecord_t *record, uint8_t mask, uint16_t kc1, uint16_t kc2) {
-    static bool modifiers = false;
+////////////
+// Morphs //
+////////////
+// Keys that send a different keycode when some modifier is held. What was sent on press is remembered per key, so
+// that the same keycode is released even if the modifiers changed in between, no matter how many overlap.
+
+typedef struct {
+    uint8_t mask;      // Modifiers that trigger the alternate keycode.
+    uint8_t base;      // Basic keycode to send when none of them are held.
+    uint8_t alternate; // Basic keycode to send otherwise.
+} morph_t;
+
+static const morph_t morphs[MORPHS_COUNT] PROGMEM = {
+    [BACKSPACE_DELETE - SAFE_RANGE] = {MOD_MASK_SHIFT, KC_BSPC, KC_DEL},
+    [BACKSPACE_ESCAPE - SAFE_RANGE] = {MOD_MASK_CTRL, KC_BSPC, KC_ESC},
+};
+
+// Whether each morph was pressed with its alternate keycode, one bit per key.
+static uint8_t morphs_alternate[(MORPHS_COUNT + 7) / 8];
+
+void process_morph(uint8_t index, keyrecord_t *record) {
+    uint8_t bit = 1 << (index % 8);
     if (record->event.pressed) {
-        modifiers = get_mods() & mask;
-        register_code(modifiers ? kc2 : kc1);
+        if (get_mods() & pgm_read_byte(&morphs[index].mask)) {
+            morphs_alternate[index / 8] |= bit;
+        } else {
+            morphs_alternate[index / 8] &= ~bit;
+        }
+    }
 
+    uint8_t keycode = morphs_alternate[index / 8] & bit ? pgm_read_byte(&morphs[index].alternate)
+                                                         : pgm_read_byte(&morphs[index].base);
+    if (record->event.pressed) {
+        register_code(keycode);
     } else {
-        unregister_code(modifiers ? kc2 : kc1);
+        unregister_code(keycode);
     }
 }
 
-bool process_record_user(uint16_t keycode, keyrecord_t *record) {
-    switch (keycode) {
-        case BACKSPACE_DELETE: {
-            custom_modifier(record, MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+//////////////
+// Snippets //
+//////////////
+// Keys that type out a whole text (see snippets.h). Rather than a report to press & another to release every
+// character, each report adds the next key on top of the ones from the previous characters (letting go of the
+// oldest once the report is full), so it's a single report per character. The host only types what's new in each
+// report, so the keys are all let go first whenever one repeats or shift needs to change.
+//
+// Anything else typed meanwhile (modifiers included) would end up in those same reports, so it's held back & only
+// sent once the snippet is done, in the same order. Presses that don't fit in the queue anymore are dropped.
 
-            return false;
+#define SNIPPETS_KEYS 6   // Keys in a report.
+#define SNIPPETS_QUEUE 16 // Key events held back while typing.
+
+typedef struct {
+    uint16_t keycode : 15; // Basic keycode, or a morph.
+    bool     pressed : 1;
+} snippet_event_t;
+
+static bool     snippet_playing = false;
+static uint16_t snippet_next;                  // Next byte in snippets_data.
+static uint16_t snippet_end;                   // Where the snippet ends in snippets_data.
+static uint8_t  snippet_stack[SNIPPETS_STACK]; // Bytes unpacked from pairs & not typed yet, the last one first.
+static uint8_t  snippet_depth;
+static uint8_t  snippet_stroke;              // Next key to press (& whether with shift), or SNIPPET_DONE.
+static uint8_t  snippet_mods;                // The user's own modifiers, given back once done.
+static uint8_t  snippet_keys[SNIPPETS_KEYS]; // Keys held in the report, the oldest first.
+static uint8_t  snippet_held;
+
+static snippet_event_t snippet_queue[SNIPPETS_QUEUE]; // Held back key events, the oldest first.
+static uint8_t         snippet_queued;
+static uint8_t         snippet_reserved; // Room kept for the releases of the presses in the queue.
+
+static uint8_t snippet_pop(void) {
+    while (true) {
+        uint8_t byte;
+        if (snippet_depth > 0) {
+            byte = snippet_stack[--snippet_depth];
+        } else if (snippet_next < snippet_end) {
+            byte = pgm_read_byte(&snippets_data[snippet_next++]);
+        } else {
+            return SNIPPET_DONE;
+        }
+
+        if (byte < SNIPPET_PAIR) {
+            return byte;
         }
 
-        case BACKSPACE_ESCAPE: {
-            custom_modifier(record, MOD_MASK_CTRL, KC_BSPC, KC_ESC);
+        snippet_stack[snippet_depth++] = pgm_read_byte(&snippets_pairs[byte - SNIPPET_PAIR][1]);
+        snippet_stack[snippet_depth++] = pgm_read_byte(&snippets_pairs[byte - SNIPPET_PAIR][0]);
+    }
+}
 
-            return false;
+void snippets_start(uint8_t index) {
+    if (snippet_playing) {
+        return; // One at a time.
+    }
+
+    snippet_playing = true;
+    snippet_next    = pgm_read_word(&snippets_offsets[index]);
+    snippet_end     = pgm_read_word(&snippets_offsets[index + 1]);
+    snippet_depth   = 0;
+    snippet_held    = 0;
+    snippet_mods    = get_mods();
+    snippet_queued  = 0;
+    snippet_stroke  = snippet_pop();
+}
+
+// Holds a key event back until the snippet is done, returns whether QMK should still go on with it (only for
+// releases of keys pressed before it started, once there's no room left for them).
+static bool snippet_defer(uint16_t keycode, bool pressed) {
+    uint8_t reserved = 0;
+    if (pressed) {
+        reserved = 1;
+    } else {
+        for (uint8_t i = 0; i < snippet_queued && snippet_reserved > 0; ++i) {
+            if (snippet_queue[i].pressed && snippet_queue[i].keycode == keycode) {
+                --snippet_reserved; // The room kept for it.
+                break;
+            }
+        }
+    }
+
+    if (snippet_queued + snippet_reserved + reserved >= SNIPPETS_QUEUE) {
+        return !pressed;
+    }
+
+    snippet_queue[snippet_queued++] = (snippet_event_t){.keycode = keycode, .pressed = pressed};
+    snippet_reserved += reserved;
+
+    return false;
+}
+
+// Sends everything that was held back, as if it was typed right now.
+static void snippet_flush(void) {
+    for (uint8_t i = 0; i < snippet_queued; ++i) {
+        snippet_event_t event = snippet_queue[i];
+        if (event.keycode >= SAFE_RANGE && event.keycode < MORPHS_END) {
+            keyrecord_t record = {.event = {.pressed = event.pressed}};
+            process_morph(event.keycode - SAFE_RANGE, &record);
+        } else if (event.pressed) {
+            register_code(event.keycode);
+        } else {
+            unregister_code(event.keycode);
         }
+    }
+
+    snippet_queued   = 0;
+    snippet_reserved = 0;
+}
+
+// Sends the next report, one per pass of the main loop.
+void snippets_task(void) {
+    if (!snippet_playing) {
+        return;
+    }
+
+    uint8_t keycode = snippet_stroke & SNIPPET_KEYCODE;
+    uint8_t mods    = snippet_stroke & SNIPPET_SHIFT ? MOD_BIT(KC_LSFT) : 0;
+    bool    repeat  = false;
+    for (uint8_t i = 0; i < snippet_held; ++i) {
+        repeat |= snippet_keys[i] == keycode;
+    }
+
+    if (snippet_stroke == SNIPPET_DONE || repeat || mods != get_mods()) {
+        for (uint8_t i = 0; i < snippet_held; ++i) {
+            del_key(snippet_keys[i]);
+        }
+        snippet_held = 0;
+
+        if (snippet_stroke == SNIPPET_DONE) {
+            snippet_playing = false;
+            set_mods(snippet_mods);
+            send_keyboard_report();
+            snippet_flush();
+        } else {
+            set_mods(mods);
+            send_keyboard_report();
+        }
+
+        return;
+    }
+
+    if (snippet_held == SNIPPETS_KEYS) {
+        del_key(snippet_keys[0]);
+        for (uint8_t i = 1; i < SNIPPETS_KEYS; ++i) {
+            snippet_keys[i - 1] = snippet_keys[i];
+        }
+        --snippet_held;
+    }
+    add_key(keycode);
+    snippet_keys[snippet_held++] = keycode;
+    send_keyboard_report();
+
+    snippet_stroke = snippet_pop();
+}
 
+// Holds back whatever would change the report while a snippet plays, returns whether QMK should still go on with
+// the key. Called for every key, in either mode (a chord can switch to gaming halfway through a snippet).
+bool process_record_snippets(uint16_t keycode, keyrecord_t *record) {
+    if (!snippet_playing) {
+        return true;
+    }
+
+    if (keycode <= QK_BASIC_MAX || (keycode >= SAFE_RANGE && keycode < MORPHS_END)) {
+        return snippet_defer(keycode, record->event.pressed);
+    }
+    if (keycode >= QK_LAYER_TAP && keycode <= QK_LAYER_TAP_MAX && record->tap.count > 0) {
+        return snippet_defer(keycode & 0xFF, record->event.pressed);
+    }
+
+    return true;
+}
+
+////////////
+// Others //
+////////////
+
+bool process_record_macros(uint16_t keycode, keyrecord_t *record) {
+    if (!process_record_snippets(keycode, record)) {
+        return false;
+    }
+
+    if (keycode >= SAFE_RANGE && keycode < MORPHS_END) {
+        process_morph(keycode - SAFE_RANGE, record);
+
+        return false;
+    }
+
+    if (keycode >= SNIPPETS_START && keycode < SNIPPETS_END) {
+        if (record->event.pressed) {
+            snippets_start(keycode - SNIPPETS_START);
+        }
+
+        return false;
+    }
+
+    switch (keycode) {
         case RGB_MODE: {
             if (record->event.pressed) {
                 rgb_next_mode();
@@ -0,0 +1,51 @@
+/***************************************************************************************************************\
+* Per mode behaviour, switched whenever the layers go from one mode to the other.                               *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// While gaming every bit of latency counts, so the extras get out of the way:
+//  - Key events go straight to QMK, without going through the custom keycodes nor the tapping term learning.
+//  - Debouncing reacts on the first change instead of waiting for the matrix to settle (see debounce.c).
+//  - The lighting is switched to a static colour, which is the cheapest effect to render. Whatever effect was in
+//    use is brought back when going back to typing.
+
+#pragma once
+
+#include "layers.h"
+
+static bool mode_gaming = false;
+
+#ifdef RGB_MATRIX_ENABLE
+static uint8_t mode_typing_effect;
+#endif // RGB_MATRIX_ENABLE
+
+layer_state_t mode_update(layer_state_t state) {
+    bool gaming = IS_GAMING(state);
+    if (gaming == mode_gaming) {
+        return state;
+    }
+    mode_gaming = gaming;
+
+#ifdef RGB_MATRIX_ENABLE
+    if (gaming) {
+        mode_typing_effect = rgb_matrix_get_mode();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_SOLID);
+    } else {
+        rgb_matrix_mode_noeeprom(mode_typing_effect);
+    }
+#endif // RGB_MATRIX_ENABLE
+
+    return state;
+}
@@ -22,33 +22,63 @@
 
 #include QMK_KEYBOARD_H
 
-void rgb_next_colour(void) {
-    static uint8_t       colour = 0;
-    static const uint8_t hues[] = {
-        0x80, // Cyan.
-        0xEB, // Magenta.
-        0x03, // Orange.
+#ifdef RGB_MATRIX_ENABLE
+
+static const uint8_t rgb_hues[] = {
+    0x80, // Cyan.
+    0xEB, // Magenta.
+    0x03, // Orange.
+
+    0x00, // White.
+};
+
+static const uint8_t rgb_modes[] = {
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    RGB_MATRIX_CUSTOM_REACTIVE,
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    RGB_MATRIX_CUSTOM_SOLID,
+    RGB_MATRIX_CUSTOM_OFF,
+};
+
+// Current position in each of the lists above (see state.h).
+static uint8_t rgb_colour = 0;
+static uint8_t rgb_mode   = 0;
 
-        0x00, // White.
-    };
+// Lowered while the keyboard is left alone (see idle.h).
+static uint8_t rgb_brightness = 0xFF;
 
-    uint8_t hue        = hues[colour];
-    uint8_t saturation = colour < sizeof(hues) - 1 ? 0xFF : 0x00;
-    uint8_t value      = 0xFF;
-    rgblight_sethsv_noeeprom(hue, saturation, value);
+void rgb_set_colour(uint8_t colour) {
+    rgb_colour = colour < sizeof(rgb_hues) ? colour : 0;
 
-    colour = (colour + 1) % sizeof(hues);
+    uint8_t hue        = rgb_hues[rgb_colour];
+    uint8_t saturation = rgb_colour < sizeof(rgb_hues) - 1 ? 0xFF : 0x00;
+    uint8_t value      = rgb_brightness;
+    rgblight_sethsv_noeeprom(hue, saturation, value); // Redrawn from the next frame on (see rgb_render.h).
 }
 
-void rgb_next_mode(void) {
-    static uint8_t       mode    = 0;
-    static const uint8_t modes[] = {
-        RGB_MATRIX_SOLID_REACTIVE_SIMPLE,
-        RGB_MATRIX_SOLID_COLOR,
-        RGB_MATRIX_CUSTOM_OFF,
-    };
+void rgb_set_brightness(uint8_t brightness) {
+    rgb_brightness = brightness;
+
+    rgb_set_colour(rgb_colour);
+}
 
-    rgblight_mode_noeeprom(modes[mode]);
+void rgb_set_mode(uint8_t mode) {
+    rgb_mode = mode < sizeof(rgb_modes) ? mode : 0;
 
-    mode = (mode + 1) % sizeof(modes);
+    rgblight_mode_noeeprom(rgb_modes[rgb_mode]);
 }
+
+void rgb_next_colour(void) {
+    rgb_set_colour((rgb_colour + 1) % sizeof(rgb_hues));
+}
+
+void rgb_next_mode(void) {
+    rgb_set_mode((rgb_mode + 1) % sizeof(rgb_modes));
+}
+
+#else // RGB_MATRIX_ENABLE
+
+static inline void rgb_next_colour(void) {}
+static inline void rgb_next_mode(void) {}
+
+#endif // RGB_MATRIX_ENABLE
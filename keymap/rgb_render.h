@@ -0,0 +1,77 @@
+/***************************************************************************************************************\
+* Incremental rendering for the custom matrix effects.                                                          *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/feature_rgb_matrix?id=custom-rgb-matrix-effects
+//
+// Static effects (i.e., those that look the same on every frame) only draw when something invalidated them, and
+// otherwise skip the whole frame (unless they still write some LEDs in it themselves, like the reactive one). No
+// LEDs are written then, so the driver has nothing to flush either. Whatever gets drawn on top of them (the
+// indicators) has to check rgb_render_drawn to do the same, and anything else changing what they look like (the
+// layer, et cetera) has to call rgb_render_invalidate. Changing effects, colour or LED flags, or turning the LEDs
+// back on, always redraws (on both halves, as those get synced over).
+//
+// The effects live in rgb_matrix_user.inc, which is built along with QMK's RGB matrix and holds the state below.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_CUSTOM_USER)
+
+extern bool    rgb_render_invalid; // Redraw on the next frame.
+extern uint8_t rgb_render_skipped; // End of the last slice left untouched by a static effect, 0 if none.
+extern uint8_t rgb_render_touched; // LEDs written so far in the current frame (only counted with CYCLES_ENABLE).
+
+#    ifdef CYCLES_ENABLE
+void cycles_rgb_begin(void); // See cycles.h.
+#    endif // CYCLES_ENABLE
+
+static inline void rgb_render_invalidate(void) {
+    rgb_render_invalid = true;
+}
+
+// Whether the slice that ends at led_max was drawn this frame, to be checked right after it was rendered.
+static inline bool rgb_render_drawn(uint8_t led_max) {
+    bool drawn         = rgb_render_skipped != led_max;
+    rgb_render_skipped = 0;
+
+    return drawn;
+}
+
+static inline void rgb_render_set(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+#    ifdef CYCLES_ENABLE
+    ++rgb_render_touched;
+#    endif // CYCLES_ENABLE
+    rgb_render_skipped = 0;
+    rgb_matrix_set_color(index, red, green, blue);
+}
+
+#elif defined(RGB_MATRIX_ENABLE)
+
+static inline void rgb_render_invalidate(void) {}
+static inline bool rgb_render_drawn(uint8_t led_max) {
+    return true;
+}
+static inline void rgb_render_set(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_matrix_set_color(index, red, green, blue);
+}
+
+#else // RGB_MATRIX_ENABLE
+
+static inline void rgb_render_invalidate(void) {}
+
+#endif // RGB_MATRIX_ENABLE
@@ -22,5 +22,30 @@ BOOTLOADER = atmel-dfu
 RGB_MATRIX_ENABLE       = yes
 RGB_MATRIX_CUSTOM_USER  = yes
 
+# Debounce depending on the mode (see debounce.c).
+DEBOUNCE_TYPE = custom
+SRC += debounce.c
+
+# Look keys up in the flattened keymap (see keymap_flat.h).
+FLAT_KEYMAP_ENABLE = yes
+ifeq ($(strip $(FLAT_KEYMAP_ENABLE)), yes)
+    OPT_DEFS += -DFLAT_KEYMAP_ENABLE
+endif
+
 # Reduce compiled size.
 LTO_ENABLE  = yes
+
+# Cycle counters, printed to the console (see cycles.h).
+CYCLES_ENABLE = no
+ifeq ($(strip $(CYCLES_ENABLE)), yes)
+    CONSOLE_ENABLE = yes
+    OPT_DEFS += -DCYCLES_ENABLE
+endif
+
+# Input latency tracing, printed to the console (see trace.h).
+TRACE_ENABLE = no
+ifeq ($(strip $(TRACE_ENABLE)), yes)
+    CONSOLE_ENABLE = yes
+    OPT_DEFS += -DTRACE_ENABLE
+    SRC += trace.c
+endif
@@ -0,0 +1,58 @@
+/***************************************************************************************************************\
+* Text typed out by the snippet keys.                                                                           *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Only what can be typed on an en-US layout, plus new lines & tabs. This is not built into the firmware as is, but
+// packed into snippets_packed.h by sim/pack.c, so run `make -C sim pack` after changing anything here.
+//
+// Packed, each character is a single byte with the basic keycode in the lower bits & whether it needs shift, and
+// then the most common pairs of bytes are repeatedly replaced by a new byte (from 0x80 up, so that they can't be
+// mistaken for a key), as long as that saves space.
+
+#pragma once
+
+#define SNIPPET_KEYCODE 0x3F // Keycode bits, enough for every key that types something.
+#define SNIPPET_SHIFT 0x40   // Typed with shift held.
+#define SNIPPET_PAIR 0x80    // First byte that stands for a pair of bytes instead.
+#define SNIPPET_DONE 0xFF    // Nothing left to type.
+
+enum {
+    SNIPPET_SIGNATURE,
+    SNIPPET_LICENCE,
+    SNIPPETS_COUNT,
+};
+
+#ifdef SNIPPETS_TEXT
+
+// clang-format off
+static const char *snippets_text[SNIPPETS_COUNT] = {
+    [SNIPPET_SIGNATURE] = "Leandro Emmanuel Reina Kiperman <@kip93>",
+
+    [SNIPPET_LICENCE] =
+    "This program is free software: you can redistribute it and/or modify it under the terms of the GNU General\n"
+    "Public License as published by the Free Software Foundation, either version 3 of the License, or (at your\n"
+    "option) any later version.\n"
+    "\n"
+    "This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the\n"
+    "implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License\n"
+    "for more details.\n"
+    "\n"
+    "You should have received a copy of the GNU General Public License along with this program. If not, see\n"
+    "<http://www.gnu.org/licenses/>.\n",
+};
+// clang-format on
+
+#endif // SNIPPETS_TEXT
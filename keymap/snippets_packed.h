@@ -0,0 +1,117 @@
+/***************************************************************************************************************\
+* Packed snippets, GENERATED by sim/pack.c from snippets.h.                                                     *
+* Don't edit by hand, run `make -C sim pack` after changing the snippets instead.                               *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+#pragma once
+
+// 650 characters packed into 502 bytes.
+
+// Bytes waiting to be unpacked at most, i.e., how deep pairs nest plus one.
+#define SNIPPETS_STACK 9
+
+// clang-format off
+static const uint8_t snippets_pairs[][2] PROGMEM = {
+    {0x08, 0x2C}, // 0x80
+    {0x17, 0x0B}, // 0x81
+    {0x08, 0x15}, // 0x82
+    {0x08, 0x11}, // 0x83
+    {0x2C, 0x81}, // 0x84
+    {0x0C, 0x16}, // 0x85
+    {0x0C, 0x06}, // 0x86
+    {0x17, 0x2C}, // 0x87
+    {0x04, 0x11}, // 0x88
+    {0x12, 0x18}, // 0x89
+    {0x2C, 0x12}, // 0x8A
+    {0x84, 0x80}, // 0x8B
+    {0x15, 0x08}, // 0x8C
+    {0x07, 0x2C}, // 0x8D
+    {0x12, 0x11}, // 0x8E
+    {0x85, 0x2C}, // 0x8F
+    {0x86, 0x83}, // 0x90
+    {0x90, 0x16}, // 0x91
+    {0x0C, 0x8E}, // 0x92
+    {0x15, 0x2C}, // 0x93
+    {0x08, 0x8D}, // 0x94
+    {0x8A, 0x09}, // 0x95
+    {0x0F, 0x2C}, // 0x96
+    {0x18, 0x05}, // 0x97
+    {0x97, 0x0F}, // 0x98
+    {0x4F, 0x91}, // 0x99
+    {0x15, 0x12}, // 0x9A
+    {0x0C, 0x87}, // 0x9B
+    {0x05, 0x18}, // 0x9C
+    {0x1A, 0x04}, // 0x9D
+    {0x44, 0x51}, // 0x9E
+    {0x4C, 0x57}, // 0x9F
+    {0x44, 0x55}, // 0xA0
+    {0x08, 0x0C}, // 0xA1
+    {0x12, 0x13}, // 0xA2
+    {0x95, 0x8B}, // 0xA3
+    {0x4A, 0x51}, // 0xA4
+    {0xA4, 0x58}, // 0xA5
+    {0xA5, 0x2C}, // 0xA6
+    {0xA6, 0x4A}, // 0xA7
+    {0xA7, 0x83}, // 0xA8
+    {0xA8, 0x82}, // 0xA9
+    {0xA9, 0x04}, // 0xAA
+    {0x53, 0x98}, // 0xAB
+    {0xAB, 0x86}, // 0xAC
+    {0xAC, 0x2C}, // 0xAD
+    {0xAD, 0x99}, // 0xAE
+    {0x1A, 0x0C}, // 0xAF
+    {0x8F, 0x13}, // 0xB0
+    {0xB0, 0x9A}, // 0xB1
+    {0xB1, 0x0A}, // 0xB2
+    {0xB2, 0x15}, // 0xB3
+    {0xB3, 0x04}, // 0xB4
+    {0xB4, 0x10}, // 0xB5
+    {0x36, 0x2C}, // 0xB6
+    {0x08, 0x28}, // 0xB7
+    {0x37, 0x28}, // 0xB8
+};
+
+static const uint16_t snippets_offsets[SNIPPETS_COUNT + 1] PROGMEM = {0, 33, 388};
+
+static const uint8_t snippets_data[] PROGMEM = {
+    0x4F, 0x08, 0x88, 0x07, 0x9A, 0x2C, 0x48, 0x10, 0x10, 0x88, 0x18, 0x08, 0x96, 0x55, 0xA1, 0x11,
+    0x04, 0x2C, 0x4E, 0x0C, 0x13, 0x82, 0x10, 0x88, 0x2C, 0x76, 0x5F, 0x0E, 0x0C, 0x13, 0x26, 0x20,
+    0x77,
+    0x57, 0x0B, 0xB5, 0x2C, 0x8F, 0x09, 0x8C, 0x80, 0x16, 0x12, 0x09, 0x17, 0x9D, 0x8C, 0x73, 0x2C,
+    0x1C, 0x89, 0x2C, 0x06, 0x88, 0x2C, 0x8C, 0x07, 0x85, 0x17, 0x15, 0x0C, 0x9C, 0x17, 0x80, 0x9B,
+    0x88, 0x07, 0x38, 0x12, 0x93, 0x10, 0x12, 0x07, 0x0C, 0x09, 0x1C, 0x2C, 0x9B, 0x18, 0x11, 0x07,
+    0x82, 0x8B, 0x17, 0x82, 0x10, 0x16, 0xA3, 0xAA, 0x0F, 0x28, 0xAE, 0x80, 0x04, 0x16, 0x2C, 0x13,
+    0x98, 0x85, 0x0B, 0x94, 0x05, 0x1C, 0x8B, 0x49, 0x8C, 0x80, 0x56, 0x12, 0x09, 0x17, 0x9D, 0x15,
+    0x80, 0x49, 0x89, 0x11, 0x07, 0x04, 0x17, 0x92, 0xB6, 0xA1, 0x81, 0x82, 0x2C, 0x19, 0x82, 0x16,
+    0x92, 0x2C, 0x20, 0xA3, 0x99, 0x08, 0x36, 0x8A, 0x93, 0x66, 0x04, 0x87, 0x1C, 0x89, 0x15, 0x28,
+    0xA2, 0x17, 0x92, 0x67, 0x2C, 0x88, 0x1C, 0x2C, 0x0F, 0x04, 0x17, 0x82, 0x2C, 0x19, 0x82, 0x16,
+    0x92, 0xB8, 0x28, 0x57, 0x0B, 0xB5, 0x2C, 0x8F, 0x07, 0x85, 0x17, 0x15, 0x0C, 0x9C, 0x17, 0x94,
+    0x0C, 0x11, 0x8B, 0x0B, 0xA2, 0x80, 0x81, 0x04, 0x87, 0x9B, 0xAF, 0x0F, 0x96, 0x05, 0x80, 0x18,
+    0x16, 0x08, 0x09, 0x18, 0x0F, 0xB6, 0x9C, 0x87, 0x5A, 0x9F, 0x4B, 0x52, 0x58, 0x57, 0x2C, 0x9E,
+    0x5C, 0x2C, 0x5A, 0xA0, 0x55, 0x9E, 0x57, 0x5C, 0x33, 0x2C, 0xAF, 0x81, 0x89, 0x87, 0x08, 0x19,
+    0x83, 0x84, 0xB7, 0x0C, 0x10, 0x13, 0x0F, 0x0C, 0x94, 0x9D, 0x15, 0x15, 0x88, 0x17, 0x1C, 0x95,
+    0x2C, 0x50, 0x48, 0x55, 0x46, 0x4B, 0x9E, 0x57, 0x44, 0x45, 0x4C, 0x4F, 0x9F, 0x5C, 0x8A, 0x93,
+    0x49, 0x9F, 0x51, 0x48, 0x56, 0x56, 0x2C, 0x49, 0x52, 0x55, 0x2C, 0x44, 0x2C, 0x53, 0xA0, 0x57,
+    0x4C, 0x46, 0x58, 0x4F, 0xA0, 0x2C, 0x53, 0x58, 0x55, 0x53, 0x52, 0x56, 0x48, 0x37, 0x2C, 0x56,
+    0x08, 0x80, 0x81, 0x80, 0xAA, 0x96, 0xAE, 0xB7, 0x09, 0x12, 0x93, 0x10, 0x12, 0x15, 0x80, 0x07,
+    0x08, 0x17, 0x04, 0x0C, 0x0F, 0x16, 0xB8, 0x28, 0x5C, 0x89, 0x2C, 0x16, 0x0B, 0x89, 0x0F, 0x8D,
+    0x0B, 0x04, 0x19, 0x80, 0x8C, 0x06, 0xA1, 0x19, 0x94, 0x04, 0x2C, 0x06, 0xA2, 0x1C, 0xA3, 0xAA,
+    0x96, 0xAE, 0x80, 0x04, 0x0F, 0x8E, 0x0A, 0x2C, 0xAF, 0x81, 0x84, 0xB5, 0x37, 0x2C, 0x4C, 0x09,
+    0x2C, 0x11, 0x12, 0x17, 0xB6, 0x16, 0x08, 0xB7, 0x76, 0x0B, 0x17, 0x17, 0x13, 0x73, 0x38, 0x38,
+    0x1A, 0x1A, 0x1A, 0x37, 0x0A, 0x11, 0x18, 0x37, 0x12, 0x15, 0x0A, 0x38, 0x0F, 0x91, 0x08, 0x16,
+    0x38, 0x77, 0xB8,
+};
+// clang-format on
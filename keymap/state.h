@@ -0,0 +1,184 @@
+/***************************************************************************************************************\
+* State that survives power cycles (e.g., the halves being split apart & put back together).                    *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/custom_quantum_functions?id=persistent-configuration-eeprom
+//
+// The mode, colour, effect & speed are kept in a ring of slots at the end of the EEPROM, each slot being written
+// in turn so that the wear is spread over all of them. Every slot ends with a sequence number (written last, so a
+// half written slot is never taken as the newest one), and the newest slot is the one right before the sequence
+// breaks. Restoring it reads at most STATE_SLOTS + 1 bytes to find it.
+//
+// Changes are only written once they've been left alone for STATE_SAVE_DELAY, so cycling through colours (or
+// going in & out of gaming mode) costs a single write. Only bytes that actually changed get written, & at most one
+// per pass of the main loop (once the last one is done), since a write takes ~3.4ms & the EEPROM functions just
+// busy wait for the one before it.
+//
+// Only the master half keeps its state. The other one gets it synced over from the master anyway.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include <string.h>
+#include "eeprom.h"
+
+#include "layers.h"
+#include "modes.h"
+#include "rgb_macros.h"
+
+#ifndef STATE_SLOTS
+#    define STATE_SLOTS 64
+#endif // STATE_SLOTS
+
+#ifndef STATE_SAVE_DELAY
+#    define STATE_SAVE_DELAY 5000
+#endif // STATE_SAVE_DELAY
+
+#ifndef eeprom_is_ready
+#    define eeprom_is_ready() true // Only AVR's (in avr/eeprom.h) has to be waited on before writing.
+#endif // eeprom_is_ready
+
+#define STATE_EMPTY 0xFF // Sequence number of an erased slot, never written.
+
+typedef struct {
+    uint8_t layer;    // Base layer of the mode.
+    uint8_t colour;   // Index in rgb_hues.
+    uint8_t effect;   // Index in rgb_modes.
+    uint8_t speed;    // Effect speed.
+    uint8_t sequence; // Goes up by 1 with every write (skipping STATE_EMPTY).
+} state_t;
+
+#define STATE_ADDRESS(slot) ((uint8_t *)(E2END + 1 - STATE_SLOTS * sizeof(state_t)) + (slot) * sizeof(state_t))
+
+static const state_t state_default = {
+    .layer    = TYPING_0,
+    .colour   = 0,    // Cyan.
+    .effect   = 0,    // Reactive.
+    .speed    = 0x40, // ~1.5s.
+    .sequence = STATE_EMPTY - 1,
+};
+
+static state_t  state_saved;
+static state_t  state_changed;
+static state_t  state_writing;                   // Being written to state_slot, a byte at a time.
+static uint8_t  state_written = sizeof(state_t); // Bytes of it written so far.
+static uint8_t  state_slot    = STATE_SLOTS - 1;
+static uint16_t state_timer;
+
+static uint8_t state_next_sequence(uint8_t sequence) {
+    return sequence + 1 < STATE_EMPTY ? sequence + 1 : 0;
+}
+
+static uint8_t state_read_sequence(uint8_t slot) {
+    return eeprom_read_byte(STATE_ADDRESS(slot) + offsetof(state_t, sequence));
+}
+
+static bool state_valid(const state_t *state) {
+    if (state->layer != TYPING_0 && state->layer != GAMING_0) {
+        return false;
+    }
+
+#ifdef RGB_MATRIX_ENABLE
+    return state->colour < sizeof(rgb_hues) && state->effect < sizeof(rgb_modes);
+#else  // RGB_MATRIX_ENABLE
+    return true;
+#endif // RGB_MATRIX_ENABLE
+}
+
+static state_t state_current(void) {
+    state_t state = state_default;
+    state.layer   = mode_gaming ? GAMING_0 : TYPING_0;
+#ifdef RGB_MATRIX_ENABLE
+    state.colour = rgb_colour;
+    state.effect = rgb_mode;
+    state.speed  = rgblight_get_speed();
+#endif // RGB_MATRIX_ENABLE
+    state.sequence = state_saved.sequence;
+
+    return state;
+}
+
+// Put back the last saved state (or the default one, if there's none).
+void state_restore(void) {
+    state_saved = state_default;
+
+    if (is_keyboard_master()) {
+        uint8_t first    = state_read_sequence(0);
+        uint8_t sequence = first;
+        for (uint8_t slot = 0; slot < STATE_SLOTS; ++slot) {
+            uint8_t next = slot + 1 < STATE_SLOTS ? state_read_sequence(slot + 1) : first;
+            if (sequence != STATE_EMPTY && next != state_next_sequence(sequence)) {
+                // Even if it's not valid (e.g., the keymap lost a colour), the next write still goes after it.
+                state_t state;
+                eeprom_read_block(&state, STATE_ADDRESS(slot), sizeof(state_t));
+                if (state_valid(&state)) {
+                    state_saved = state;
+                }
+                state_saved.sequence = state.sequence;
+                state_slot           = slot;
+                break;
+            }
+            sequence = next;
+        }
+    }
+
+#ifdef RGB_MATRIX_ENABLE
+    rgb_set_colour(state_saved.colour);
+    rgb_set_mode(state_saved.effect);
+    rgblight_set_speed_noeeprom(state_saved.speed);
+#endif // RGB_MATRIX_ENABLE
+    if (state_saved.layer != TYPING_0) {
+        layer_move(state_saved.layer);
+    }
+
+    state_changed = state_saved;
+}
+
+// Called once per pass of the main loop.
+void state_task(void) {
+    if (!is_keyboard_master()) {
+        return;
+    }
+
+    if (state_written < sizeof(state_t)) {
+        if (eeprom_is_ready()) {
+            // In order, so the sequence number goes last.
+            eeprom_update_byte(STATE_ADDRESS(state_slot) + state_written,
+                               ((const uint8_t *)&state_writing)[state_written]);
+            if (++state_written == sizeof(state_t)) {
+                state_saved            = state_writing;
+                state_changed.sequence = state_writing.sequence;
+            }
+        }
+        return;
+    }
+
+    state_t state = state_current();
+    if (memcmp(&state, &state_changed, sizeof(state_t)) != 0) {
+        state_changed = state;
+        state_timer   = timer_read();
+        return;
+    }
+
+    if (memcmp(&state, &state_saved, sizeof(state_t)) == 0 || timer_elapsed(state_timer) < STATE_SAVE_DELAY) {
+        return;
+    }
+
+    state_slot             = (state_slot + 1) % STATE_SLOTS;
+    state_writing          = state;
+    state_writing.sequence = state_next_sequence(state_saved.sequence);
+    state_written          = 0;
+}
@@ -0,0 +1,146 @@
+/***************************************************************************************************************\
+* Adaptive tapping term for the dual-role keys.                                                                 *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/tap_hold?id=tapping-term
+//
+// Each dual-role key remembers how long its last few taps were held down, including the ones rolled over into the
+// next key (which is where fast typing holds them the longest). The tapping term of the key is then a percentile
+// of those plus some margin, so that a key that is tapped quickly resolves holds sooner while one that is held a
+// bit longer when typing stops misfiring as a hold (& a single slow tap doesn't keep the term high on its own).
+//
+// Short holds that did nothing (i.e., no other key was pressed while the layer was active) are taken as misfired
+// taps, and learnt as such too. So are short holds that the tapping term ran out on while the next key was already
+// down, which is what rolling over from a tap into the next key looks like when the tap takes longer than the
+// tapping term. Holds decided before that (i.e., PERMISSIVE_HOLD, the next key being both pressed & released) are
+// meant as such, and not learnt from, & neither are holds longer than TAPPING_TERM_MAX (e.g., resting a thumb on
+// the key).
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "layers.h"
+
+#ifndef TAPPING_TERM_MIN
+#    define TAPPING_TERM_MIN 100
+#endif // TAPPING_TERM_MIN
+#ifndef TAPPING_TERM_MAX
+#    define TAPPING_TERM_MAX 250
+#endif // TAPPING_TERM_MAX
+#ifndef TAPPING_TERM_MARGIN
+#    define TAPPING_TERM_MARGIN 50
+#endif // TAPPING_TERM_MARGIN
+#ifndef TAPPING_TERM_PERCENTILE
+#    define TAPPING_TERM_PERCENTILE 85
+#endif // TAPPING_TERM_PERCENTILE
+
+// Taps remembered per key, & which one of them (from the shortest) the tapping term is taken from.
+#define TAPPING_SAMPLES 8
+#define TAPPING_SAMPLE ((TAPPING_SAMPLES * TAPPING_TERM_PERCENTILE + 99) / 100 - 1)
+
+/////////////////////////////////////////////////////// Keys ////////////////////////////////////////////////////
+
+static const uint16_t tapping_keys[] = {
+    LT(T1, KC_SPC),
+    LT(T2, KC_ENT),
+};
+
+#define TAPPING_KEYS (sizeof(tapping_keys) / sizeof(tapping_keys[0]))
+
+/////////////////////////////////////////////////////// Stats ///////////////////////////////////////////////////
+
+typedef struct {
+    uint8_t  samples[TAPPING_SAMPLES]; // Tap durations (ms), as a ring buffer.
+    uint8_t  next;                     // Where the next sample goes.
+    uint16_t term;                     // Current tapping term, updated with each sample.
+    uint16_t pressed;                  // When the key was last pressed.
+    bool     used;                     // Whether a key was pressed while holding this one.
+    bool     rolled;                   // Whether the term ran out on it with another key already down.
+} tapping_stats_t;
+
+static tapping_stats_t tapping_stats[TAPPING_KEYS];
+
+static tapping_stats_t *tapping_get_stats(uint16_t keycode) {
+    for (uint8_t i = 0; i < TAPPING_KEYS; ++i) {
+        if (tapping_keys[i] == keycode) {
+            return &tapping_stats[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void tapping_learn(tapping_stats_t *stats, uint16_t duration) {
+    stats->samples[stats->next] = duration < UINT8_MAX ? duration : UINT8_MAX;
+    stats->next                 = (stats->next + 1) % TAPPING_SAMPLES;
+
+    // Insertion sort, there's only a handful of them.
+    uint8_t sorted[TAPPING_SAMPLES];
+    for (uint8_t i = 0; i < TAPPING_SAMPLES; ++i) {
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > stats->samples[i]; --j) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = stats->samples[i];
+    }
+
+    uint16_t term = sorted[TAPPING_SAMPLE] + TAPPING_TERM_MARGIN;
+    stats->term   = term < TAPPING_TERM_MIN ? TAPPING_TERM_MIN : term > TAPPING_TERM_MAX ? TAPPING_TERM_MAX : term;
+}
+
+void tapping_init(void) {
+    // Start as if every sample had been right at the default tapping term.
+    for (uint8_t i = 0; i < TAPPING_KEYS; ++i) {
+        for (uint8_t j = 0; j < TAPPING_SAMPLES; ++j) {
+            tapping_stats[i].samples[j] = TAPPING_TERM - TAPPING_TERM_MARGIN;
+        }
+        tapping_stats[i].term = TAPPING_TERM;
+    }
+}
+
+// Keep track of every key event, to be called for all of them from process_record_user.
+void tapping_record(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed) {
+        for (uint8_t i = 0; i < TAPPING_KEYS; ++i) {
+            tapping_stats[i].used = true;
+        }
+    }
+
+    tapping_stats_t *stats = tapping_get_stats(keycode);
+    if (!stats) {
+        return;
+    }
+
+    if (record->event.pressed) {
+        stats->pressed = record->event.time;
+        stats->used    = false;
+        // A hold only gets here once decided, so the time since it was pressed says whether the term ran out.
+        stats->rolled = record->tap.count == 0 && record->tap.interrupted &&
+                        TIMER_DIFF_16(timer_read(), record->event.time) >= stats->term;
+        return;
+    }
+
+    uint16_t duration = TIMER_DIFF_16(record->event.time, stats->pressed);
+    if (record->tap.count > 0 || ((!stats->used || stats->rolled) && duration < TAPPING_TERM_MAX)) {
+        tapping_learn(stats, duration);
+    }
+}
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    tapping_stats_t *stats = tapping_get_stats(keycode);
+
+    return stats ? stats->term : TAPPING_TERM;
+}
@@ -0,0 +1,173 @@
+/***************************************************************************************************************\
+* Input latency tracing (see trace.h).                                                                          *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Events are kept in a ring buffer in SRAM, and printed out a couple per pass of the main loop so that draining
+// it never holds the scan up for long. Each one as a line of `trace <time in µs> <event> <row> <col>`, where the
+// event is one of:
+//  * d/u: the switch was seen going down/up in the raw matrix (i.e., before debouncing).
+//  * p/r: process_record_user was entered for a press/release.
+//  * x:   process_record_user returned.
+//  * t/h: a dual-role key (LT) was decided as a tap/hold, right as its press got to process_record_user.
+//  * s:   a keyboard report was sent, with the number of keys in it in place of the row (col is always 0).
+//
+// Once the buffer fills up, nothing else is recorded until it's been printed out, and then the gap is reported as
+// `trace dropped <events>`.
+//
+// Only the half that's plugged in gets to see its raw matrix, so keys from the other half start at p/r (they are
+// debounced over there & then sent over the split link).
+
+#include QMK_KEYBOARD_H
+#include "host.h"
+#include "print.h"
+#include "trace.h"
+
+#ifdef __AVR__
+#    include <avr/interrupt.h>
+#endif // __AVR__
+
+// Events kept at once, at most 255.
+#ifndef TRACE_SIZE
+#    define TRACE_SIZE 64
+#endif // TRACE_SIZE
+
+// Events printed per pass of the main loop.
+#ifndef TRACE_DRAIN
+#    define TRACE_DRAIN 2
+#endif // TRACE_DRAIN
+
+// QMK runs timer 0 in CTC mode with a prescaler of 64, overflowing once per ms.
+#define TRACE_TICKS_PER_MS (F_CPU / 64 / 1000)
+
+typedef struct {
+    uint32_t time;  // µs
+    char     event; // See above.
+    uint8_t  key;   // Row in the upper nibble, col in the lower one.
+} trace_entry_t;
+
+static trace_entry_t trace_buffer[TRACE_SIZE];
+static uint8_t       trace_head    = 0; // Oldest event, i.e., the next one to be printed.
+static uint8_t       trace_count   = 0;
+static uint16_t      trace_dropped = 0;
+
+static matrix_row_t trace_raw[MATRIX_ROWS];
+
+static host_driver_t *trace_host;
+static host_driver_t  trace_driver;
+
+static uint32_t trace_now(void) {
+#ifdef __AVR__
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t ms    = timer_read32();
+    uint8_t  ticks = TCNT0;
+    if ((TIFR0 & _BV(OCF0A)) && ticks < TRACE_TICKS_PER_MS / 2) {
+        ++ms; // Overflowed, but the interrupt did not get to run yet.
+    }
+    SREG = sreg;
+
+    return ms * 1000 + (uint32_t)ticks * 1000 / TRACE_TICKS_PER_MS;
+#else  // __AVR__
+    return timer_read32() * 1000; // Only ms on the host.
+#endif // __AVR__
+}
+
+static void trace_add(char event, uint8_t row, uint8_t col) {
+    if (trace_dropped > 0 || trace_count == TRACE_SIZE) {
+        if (trace_dropped < UINT16_MAX) {
+            ++trace_dropped;
+        }
+        return;
+    }
+
+    trace_buffer[(trace_head + trace_count++) % TRACE_SIZE] = (trace_entry_t){
+        .time  = trace_now(),
+        .event = event,
+        .key   = (row << 4) | col,
+    };
+}
+
+static void trace_send_keyboard(report_keyboard_t *report) {
+    uint8_t keys = 0;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; ++i) {
+        keys += report->keys[i] != KC_NO;
+    }
+
+    trace_host->send_keyboard(report);
+    trace_add('s', keys, 0);
+}
+
+// Sit in between QMK & the USB driver to see the reports go out. Only done once the main loop is running, since
+// the USB driver is set after keyboard_post_init_user (and could be set again later on).
+static void trace_hook(void) {
+    host_driver_t *host = host_get_driver();
+    if (host == NULL || host == &trace_driver) {
+        return;
+    }
+
+    trace_host                 = host;
+    trace_driver               = *host;
+    trace_driver.send_keyboard = trace_send_keyboard;
+    host_set_driver(&trace_driver);
+}
+
+// Called once per pass of the main loop.
+void trace_task(void) {
+    trace_hook();
+
+    for (uint8_t i = 0; i < TRACE_DRAIN && trace_count > 0; ++i) {
+        trace_entry_t entry = trace_buffer[trace_head];
+        trace_head          = (trace_head + 1) % TRACE_SIZE;
+        --trace_count;
+
+        uprintf("trace %lu %c %u %u\n", (unsigned long)entry.time, entry.event, entry.key >> 4, entry.key & 0x0F);
+    }
+
+    if (trace_count == 0 && trace_dropped > 0) {
+        uprintf("trace dropped %u\n", trace_dropped);
+        trace_dropped = 0;
+    }
+}
+
+// Called by debounce with the raw matrix of this half, whenever it changed.
+void trace_matrix(matrix_row_t raw[], uint8_t num_rows) {
+    uint8_t offset = num_rows < MATRIX_ROWS && !is_keyboard_left() ? MATRIX_ROWS - num_rows : 0;
+
+    for (uint8_t row = 0; row < num_rows; ++row) {
+        matrix_row_t delta = raw[row] ^ trace_raw[row];
+        for (uint8_t col = 0; delta && col < MATRIX_COLS; ++col) {
+            matrix_row_t mask = (matrix_row_t)1 << col;
+            if (delta & mask) {
+                trace_add(raw[row] & mask ? 'd' : 'u', row + offset, col);
+                delta &= ~mask;
+            }
+        }
+        trace_raw[row] = raw[row];
+    }
+}
+
+void trace_record_begin(uint16_t keycode, keyrecord_t *record) {
+    keypos_t key = record->event.key;
+
+    trace_add(record->event.pressed ? 'p' : 'r', key.row, key.col);
+    if (record->event.pressed && keycode >= QK_LAYER_TAP && keycode <= QK_LAYER_TAP_MAX) {
+        trace_add(record->tap.count > 0 ? 't' : 'h', key.row, key.col);
+    }
+}
+
+void trace_record_end(keyrecord_t *record) {
+    trace_add('x', record->event.key.row, record->event.key.col);
+}
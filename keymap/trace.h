@@ -0,0 +1,42 @@
+/***************************************************************************************************************\
+* Input latency tracing.                                                                                        *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// https://docs.qmk.fm/#/faq_debug
+//
+// Only built with `TRACE_ENABLE = yes` (see rules.mk & trace.c). Every step a key goes through, from the switch
+// changing to the report leaving for the PC, is recorded with a timestamp into a small buffer in SRAM, which is
+// then printed out to the console (`qmk console`) in between keys. The output can be decoded with sim/decode.c.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#ifdef TRACE_ENABLE
+
+void trace_task(void);
+void trace_matrix(matrix_row_t raw[], uint8_t num_rows);
+void trace_record_begin(uint16_t keycode, keyrecord_t *record);
+void trace_record_end(keyrecord_t *record);
+
+#else // TRACE_ENABLE
+
+static inline void trace_task(void) {}
+static inline void trace_matrix(matrix_row_t raw[], uint8_t num_rows) {}
+static inline void trace_record_begin(uint16_t keycode, keyrecord_t *record) {}
+static inline void trace_record_end(keyrecord_t *record) {}
+
+#endif // TRACE_ENABLE
@@ -450,12 +450,137 @@ pkgs.mkShell {
       return "''${XC}"
     }
 
+    benchmark() {
+      local XC=0
+
+      local KEYMAP_ID="$('${coreutils}/bin/cat' /proc/sys/kernel/random/uuid)"
+      local KEYMAP_DIR="''${_ROOT_DIR}"/'QMK/keyboards/${KEYBOARD}/keymaps'/"''${KEYMAP_ID}"
+
+      # Each variant drops a single feature, as `<name>:<sed script>` applied to every file of the keymap.
+      local custom="$(
+        '${gnugrep}/bin/grep' -oP '(?<=^RGB_MATRIX_EFFECT\()\w+' "''${_ROOT_DIR}/keymap/rgb_matrix_user.inc" |
+          '${coreutils}/bin/paste' -sd '|'
+      )"
+      local variants=(
+        'Everything:'
+        'RGB_MATRIX_ENABLE:s/^(RGB_MATRIX_ENABLE\s*=\s*)yes/\1no/'
+        "RGB_MATRIX_CUSTOM_USER:s/^(RGB_MATRIX_CUSTOM_USER\s*=\s*)yes/\1no/;s/\bRGB_MATRIX_CUSTOM_(''${custom})\b/RGB_MATRIX_NONE/"
+        'RGB_MATRIX_KEYPRESSES:/define RGB_MATRIX_KEY(PRESSES|RELEASES)$/d'
+      )
+      local effect
+      for effect in $(
+        '${gnugrep}/bin/grep' -oP '(?<=define ENABLE_RGB_MATRIX_)\w+' "''${_ROOT_DIR}/keymap/config.h"
+      ) ; do
+        variants+=("ENABLE_RGB_MATRIX_''${effect}:/define ENABLE_RGB_MATRIX_''${effect}$/d;s/\bRGB_MATRIX_''${effect}\b/RGB_MATRIX_NONE/")
+      done
+
+      '${coreutils}/bin/printf' \
+        '# \033[3mFlash & SRAM usage per feature\033[0m ---------------------------------------------------------------------- #\n' ;
+      '${coreutils}/bin/printf' '%-48s %12s %12s\n' 'Feature (removed)' 'Flash (B)' 'SRAM (B)' ;
+      local variant sizes full_flash full_sram failed=0
+      for variant in "''${variants[@]}" ; do
+        sizes="$(
+          '${coreutils}/bin/rm' -rf -- "''${KEYMAP_DIR}" &&
+            '${coreutils}/bin/cp' -rf -- "''${_ROOT_DIR}/keymap" "''${KEYMAP_DIR}" &&
+            '${gnused}/bin/sed' -E -i "''${variant#*:}" "''${KEYMAP_DIR}"/{rules.mk,*.c,*.h,*.inc} &&
+            cd "''${_ROOT_DIR}/QMK" &&
+            '${nix}/bin/nix-shell' --pure --run "
+              qmk clean >/dev/null &&
+                qmk compile -j '${builtins.toString PARALLEL}' -kb '${KEYBOARD}' -km '$KEYMAP_ID' >/dev/null 2>&1 &&
+                avr-size --format=avr --mcu=atmega32u4 .build/*.elf
+            " |
+              '${gawk}/bin/awk' '/^(Program|Data):/ { printf "%s ", $2 }' ;
+        )" || failed=1 ;
+
+        set -- ''${sizes}
+        if [ "$#" -ne 2 ] ; then
+          '${coreutils}/bin/printf' '%-48s %12s %12s\n' "''${variant%%:*}" 'ERROR' 'ERROR' ;
+          failed=1 ;
+        elif [ -z "''${full_flash}" ] ; then
+          full_flash="$1" ; full_sram="$2" ;
+          '${coreutils}/bin/printf' '%-48s %12d %12d\n' "''${variant%%:*}" "$1" "$2" ;
+        else
+          '${coreutils}/bin/printf' '%-48s %+12d %+12d\n' "''${variant%%:*}" "$(( $1 - full_flash ))" "$(( $2 - full_sram ))" ;
+        fi
+      done
+      [ "''${failed}" -eq 0 ] || XC="$(( "''${XC}" + 0x01 ))" ;
+      '${coreutils}/bin/printf' '\n' ;
+
+      '${coreutils}/bin/printf' \
+        '# \033[3mCompile with cycle counters\033[0m ------------------------------------------------------------------------- #\n' ;
+      (
+        '${coreutils}/bin/rm' -rf -- "''${KEYMAP_DIR}" &&
+          '${coreutils}/bin/ln' -sf "''${_ROOT_DIR}/keymap" "''${KEYMAP_DIR}" &&
+          cd "''${_ROOT_DIR}/QMK" &&
+          '${nix}/bin/nix-shell' --pure --run "
+            qmk clean &&
+              qmk compile -e CYCLES_ENABLE=yes -j '${builtins.toString PARALLEL}' -kb '${KEYBOARD}' -km '$KEYMAP_ID'
+          " &&
+          '${coreutils}/bin/mkdir' -p "''${_ROOT_DIR}/.build" &&
+          '${coreutils}/bin/ls' "''${_ROOT_DIR}/QMK/.build"/*.hex |
+            '${coreutils}/bin/head' -1 |
+            '${findutils}/bin/xargs' -i cp -f -- '{}' "''${_ROOT_DIR}/.build/firmware-cycles.hex" &&
+          '${coreutils}/bin/printf' 'Extracted .build/firmware-cycles.hex\n' &&
+          '${coreutils}/bin/printf' '\033[3mFlash it and run `qmk console` to see the cycle counts.\033[0m\n' ;
+      ) || XC="$(( "''${XC}" + 0x02 ))" ;
+      '${coreutils}/bin/printf' '\n' ;
+
+      '${coreutils}/bin/printf' \
+        '# \033[3mCompile with latency tracing\033[0m ------------------------------------------------------------------------ #\n' ;
+      (
+        cd "''${_ROOT_DIR}/QMK" &&
+          '${nix}/bin/nix-shell' --pure --run "
+            qmk clean &&
+              qmk compile -e TRACE_ENABLE=yes -j '${builtins.toString PARALLEL}' -kb '${KEYBOARD}' -km '$KEYMAP_ID'
+          " &&
+          '${coreutils}/bin/mkdir' -p "''${_ROOT_DIR}/.build" &&
+          '${coreutils}/bin/ls' "''${_ROOT_DIR}/QMK/.build"/*.hex |
+            '${coreutils}/bin/head' -1 |
+            '${findutils}/bin/xargs' -i cp -f -- '{}' "''${_ROOT_DIR}/.build/firmware-trace.hex" &&
+          '${coreutils}/bin/printf' 'Extracted .build/firmware-trace.hex\n' &&
+          '${coreutils}/bin/printf' '\033[3mFlash it and pipe `qmk console` into sim/.build/decode to see the latencies.\033[0m\n' ;
+      ) || XC="$(( "''${XC}" + 0x04 ))" ;
+      '${coreutils}/bin/printf' '\n' ;
+
+      '${coreutils}/bin/printf' \
+        '# \033[3mClean up\033[0m -------------------------------------------------------------------------------------------- #\n' ;
+      (
+        '${git}/bin/git' -C "''${_ROOT_DIR}/QMK" clean -df ;
+      ) || XC="$(( "''${XC}" + 0x08 ))" ;
+      '${coreutils}/bin/printf' '\n' ;
+
+      return "''${XC}"
+    }
+
+    simulate() {
+      local XC=0
+
+      '${coreutils}/bin/printf' \
+        '# \033[3mBuild simulator\033[0m ------------------------------------------------------------------------------------- #\n' ;
+      (
+        '${gnumake}/bin/make' -C "''${_ROOT_DIR}/sim" ;
+      ) || XC="$(( "''${XC}" + 0x01 ))" ;
+      '${coreutils}/bin/printf' '\n' ;
+
+      if [ "''${XC}" -eq 0 ] ; then
+        '${coreutils}/bin/printf' \
+          '# \033[3mReplay traces\033[0m --------------------------------------------------------------------------------------- #\n' ;
+        (
+          '${gnumake}/bin/make' -s -C "''${_ROOT_DIR}/sim" bench ;
+        ) || XC="$(( "''${XC}" + 0x02 ))" ;
+      fi
+
+      return "''${XC}"
+    }
+
     help() {
       '${coreutils}/bin/cat' <<EOF | MANPAGER="''${MANPAGER:-''${PAGER:-${most}/bin/most -s}}" '${man}/bin/man' -l - 2>/dev/null
     .TH "NIX+QMK" "1" "" "" "Nix+QMK toolbox"
     .\----------------------------------------------------------------------------\.
     .SH NAME
-    .IP clean .9i
+    .IP benchmark .9i
+    - Report flash & SRAM per feature, and build a firmware with cycle counters.
+    .IP clean
     - Clean workdir.
     .IP compile
     - Build the keymap into a flashable .hex file.
@@ -471,6 +596,8 @@ pkgs.mkShell {
     - Run a simple lint on the keymap source code.
     .IP setup
     - Configure the work environment.
+    .IP simulate
+    - Check the generated headers, then replay the recorded key traces on the host and report on latency.
     .IP update
     - Update QMK to latest version.
     .IP welcome
@@ -513,6 +640,8 @@ pkgs.mkShell {
     format
     # Check code
     lint
+    # Check the changes against the recorded traces
+    simulate
     # Once done editing, compile the code
     compile
     # After the code compiled successfully, flash it
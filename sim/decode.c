@@ -0,0 +1,275 @@
+/***************************************************************************************************************\
+* Decode the latency trace printed to the console by keymap/trace.c.                                            *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Usage: decode [-t] < <console log>
+//
+// Reads the output of `qmk console` (or of a replay built with tracing, see the Makefile), ignoring anything that
+// is not a trace line, and follows every key press from the switch going down to the first report sent after it.
+// Each press is split into:
+//  * matrix → record: debouncing, plus any time QMK held the key back waiting on a dual-role key.
+//  * record:          process_record_user, up to it returning or sending a report from within.
+//  * record → report: the rest of QMK, until the report is handed over to USB.
+// And for the dual-role keys, how long it took to decide between a tap & a hold.
+//
+// For each of those a histogram is printed at the end. With `-t` every press is also printed as it completes, as
+// a timeline. Presses on the half not plugged in have no matrix time, so they only count towards the later stages.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROWS 8
+#define COLS 6
+
+#define LINE_LENGTH 256
+
+///////////////////////////////////////////////////// Stats /////////////////////////////////////////////////////
+
+// Upper bounds (µs) of each bucket, the last one taking everything else.
+static const uint32_t buckets[] = {500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, UINT32_MAX};
+
+#define BUCKETS (sizeof(buckets) / sizeof(buckets[0]))
+#define BAR_WIDTH 50
+
+typedef struct {
+    const char *name;
+    uint32_t    count;
+    uint64_t    total;
+    uint32_t    max;
+    uint32_t    hits[BUCKETS];
+} histogram_t;
+
+static histogram_t matrix_record = {.name = "matrix -> record"};
+static histogram_t record        = {.name = "record"};
+static histogram_t record_report = {.name = "record -> report"};
+static histogram_t total         = {.name = "matrix -> report"};
+static histogram_t decision      = {.name = "matrix -> tap/hold decided"};
+
+static void histogram_add(histogram_t *histogram, uint32_t us) {
+    size_t i = 0;
+    while (us >= buckets[i] && i < BUCKETS - 1) {
+        ++i;
+    }
+
+    ++histogram->count;
+    ++histogram->hits[i];
+    histogram->total += us;
+    if (us > histogram->max) {
+        histogram->max = us;
+    }
+}
+
+static void histogram_print(const histogram_t *histogram) {
+    printf("%s: %u presses", histogram->name, histogram->count);
+    if (histogram->count == 0) {
+        printf("\n\n");
+        return;
+    }
+    printf(", %.3f ms mean, %.3f ms max\n", histogram->total / 1000.0 / histogram->count, histogram->max / 1000.0);
+
+    uint32_t most = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        most = histogram->hits[i] > most ? histogram->hits[i] : most;
+    }
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        if (i < BUCKETS - 1) {
+            printf("  < %7.1f ms %6u", buckets[i] / 1000.0, histogram->hits[i]);
+        } else {
+            printf("  >=%7.1f ms %6u", buckets[i - 1] / 1000.0, histogram->hits[i]);
+        }
+        printf(histogram->hits[i] > 0 ? " " : "");
+        for (uint32_t j = 0; j < (uint64_t)histogram->hits[i] * BAR_WIDTH / most; ++j) {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+    putchar('\n');
+}
+
+///////////////////////////////////////////////////// Presses ///////////////////////////////////////////////////
+
+typedef struct {
+    bool     active;
+    bool     seen_down; // Otherwise it came from the other half.
+    bool     seen_begin;
+    bool     seen_end;
+    char     decision; // 't', 'h' or '\0' when not a dual-role key.
+    uint32_t down;
+    uint32_t begin;
+    uint32_t end;
+    uint32_t decided;
+} press_t;
+
+static press_t presses[ROWS][COLS];
+
+static bool     timeline   = false;
+static uint32_t unreported = 0;
+static uint32_t dropped    = 0;
+
+static void press_finish(uint8_t row, uint8_t col, bool reported, uint32_t report) {
+    press_t *press = &presses[row][col];
+    press->active  = false;
+    if (!reported) {
+        ++unreported;
+        return;
+    }
+
+    // Reports sent from within process_record_user end the record stage early.
+    uint32_t end = press->seen_end && press->end - press->begin < report - press->begin ? press->end : report;
+
+    histogram_add(&record, end - press->begin);
+    histogram_add(&record_report, report - end);
+    if (press->seen_down) {
+        histogram_add(&matrix_record, press->begin - press->down);
+        histogram_add(&total, report - press->down);
+    }
+
+    if (timeline) {
+        printf("%12.6f s  key %u,%u", (press->seen_down ? press->down : press->begin) / 1e6, row, col);
+        if (press->seen_down) {
+            printf("  matrix -> record %8.3f", (press->begin - press->down) / 1000.0);
+        } else {
+            printf("  %25s", "(other half)");
+        }
+        printf("  record %6.3f  -> report %6.3f", (end - press->begin) / 1000.0, (report - end) / 1000.0);
+        if (press->seen_down) {
+            printf("  total %8.3f ms", (report - press->down) / 1000.0);
+        }
+        if (press->decision) {
+            printf("  (%s)", press->decision == 't' ? "tap" : "hold");
+        }
+        putchar('\n');
+    }
+}
+
+static void trace_event(uint32_t time, char event, uint8_t row, uint8_t col) {
+    if (event != 's' && (row >= ROWS || col >= COLS)) {
+        return;
+    }
+    press_t *press = event != 's' ? &presses[row][col] : NULL;
+
+    switch (event) {
+        case 'd':
+            if (press->active && press->seen_end) {
+                press_finish(row, col, false, 0);
+            }
+            *press = (press_t){.active = true, .seen_down = true, .down = time};
+            break;
+
+        case 'p':
+            // Anything still waiting on a report by the time another key gets processed didn't send one (e.g.,
+            // layer keys).
+            for (uint8_t r = 0; r < ROWS; ++r) {
+                for (uint8_t c = 0; c < COLS; ++c) {
+                    press_t *other = &presses[r][c];
+                    if (other != press && other->active && other->seen_end) {
+                        press_finish(r, c, false, 0);
+                    }
+                }
+            }
+
+            if (!press->active || press->seen_begin) {
+                *press = (press_t){.active = true};
+            }
+            press->seen_begin = true;
+            press->begin      = time;
+            break;
+
+        case 't':
+        case 'h':
+            if (press->active) {
+                press->decision = event;
+                press->decided  = time;
+                if (press->seen_down) {
+                    histogram_add(&decision, time - press->down);
+                }
+                if (event == 'h') {
+                    press->active = false; // Holds are never reported.
+                }
+            }
+            break;
+
+        case 'x':
+            if (press->active && !press->seen_end) {
+                press->seen_end = true;
+                press->end      = time;
+            }
+            break;
+
+        case 's':
+            for (uint8_t r = 0; r < ROWS; ++r) {
+                for (uint8_t c = 0; c < COLS; ++c) {
+                    if (presses[r][c].active && presses[r][c].seen_begin) {
+                        press_finish(r, c, true, time);
+                    }
+                }
+            }
+            break;
+    }
+}
+
+////////////////////////////////////////////////////// Main /////////////////////////////////////////////////////
+
+int main(int argc, char *argv[]) {
+    if (argc == 2 && strcmp(argv[1], "-t") == 0) {
+        timeline = true;
+    } else if (argc != 1) {
+        fprintf(stderr, "Usage: %s [-t] < <console log>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char line[LINE_LENGTH];
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        const char *trace = strstr(line, "trace ");
+        if (trace == NULL) {
+            continue;
+        }
+
+        unsigned long time;
+        unsigned      row, col, count;
+        char          event;
+        if (sscanf(trace, "trace dropped %u", &count) == 1) {
+            dropped += count;
+            memset(presses, 0, sizeof(presses)); // Can't tell what happened in between.
+        } else if (sscanf(trace, "trace %lu %c %u %u", &time, &event, &row, &col) == 4) {
+            trace_event(time, event, row, col);
+        }
+    }
+
+    for (uint8_t row = 0; row < ROWS; ++row) {
+        for (uint8_t col = 0; col < COLS; ++col) {
+            if (presses[row][col].active && presses[row][col].seen_end) {
+                press_finish(row, col, false, 0);
+            }
+        }
+    }
+
+    if (timeline) {
+        putchar('\n');
+    }
+    histogram_print(&total);
+    histogram_print(&matrix_record);
+    histogram_print(&record);
+    histogram_print(&record_report);
+    histogram_print(&decision);
+    printf("Presses without a report: %u\n", unreported);
+    printf("Events dropped: %u\n", dropped);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/***************************************************************************************************************\
+* Flattened keymap, generated from keymaps[] (see keymap.c) or checked against it.                              *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Usage: flatten <keymap.c>
+//
+// Built without FLAT_KEYMAP_ENABLE, it prints keymap_flat.h: every layer already resolved over the layers it can
+// be stacked on top of, so that the top one never has a transparent key left & a lookup is a single read. Which
+// key ends up where is worked out from keymaps[], but each one is written out the same way it's written in
+// keymap.c (e.g., `LT(T1,KC_SPC)`), so that nothing in it depends on how this QMK stand-in numbers them.
+//
+// Built with it, it goes through every stack of layers that can actually be active & every key position, and
+// checks that the flattened keymap gives the same keycode as walking keymaps[] the way QMK does. It fails if any
+// of them differs, or if looking it up took more than a single read from flash.
+//
+// The stacks are each layer on top of the first layer of its mode & the default layer (so T1 & T2 over T0, G1
+// over G0 over T0). T1 & T2 are never active at the same time, since each one has the other's layer key replaced
+// with the switch to gaming mode.
+
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "layers.h"
+
+#define LAYERS (GAMING_1 + 1)
+
+static const char *names[LAYERS] = {
+    [TYPING_0] = "TYPING_0", [TYPING_1] = "TYPING_1", [TYPING_2] = "TYPING_2",
+    [GAMING_0] = "GAMING_0", [GAMING_1] = "GAMING_1",
+};
+
+// Layers that are active whenever the given one is the top layer.
+static layer_state_t stack(uint8_t layer) {
+    layer_state_t mode = (TYPING_LAYERS & (1UL << layer)) ? TYPING_LAYERS : GAMING_LAYERS;
+
+    return (1UL << layer) | (mode & -mode) | (1UL << TYPING_0);
+}
+
+// QMK's resolution: the first non transparent key, from the top active layer down. Gives the layer it's in, or the
+// top one if they're all transparent.
+static uint8_t source(layer_state_t layers, uint8_t row, uint8_t col) {
+    for (int8_t i = LAYERS - 1; i >= 0; --i) {
+        if (layers & (1UL << i) && pgm_read_word(&keymaps[i][row][col]) != KC_TRNS) {
+            return i;
+        }
+    }
+    return get_highest_layer(layers);
+}
+
+// And the keycode from there.
+static uint16_t resolve(layer_state_t layers, uint8_t row, uint8_t col) {
+    return pgm_read_word(&keymaps[source(layers, row, col)][row][col]);
+}
+
+#ifndef FLAT_KEYMAP_ENABLE
+
+#    include <ctype.h>
+#    include <string.h>
+
+#    define LAYOUT_KEYS 42
+
+// Where each argument of LAYOUT_split_3x6_3 ends up in the matrix, counting from 1 (0 is none).
+// clang-format off
+static const uint8_t layout[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_split_3x6_3(
+     1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12,
+    13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+                37, 38, 39, 40, 41, 42
+);
+// clang-format on
+
+// Every key as written in keymap.c, without whitespace.
+static char keys[LAYERS][LAYOUT_KEYS][32];
+
+// Reads the arguments of every LAYOUT_split_3x6_3 in keymap.c, skipping comments.
+static bool parse(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+
+    static char text[1 << 16];
+    size_t      length = fread(text, 1, sizeof(text) - 1, file);
+    fclose(file);
+    text[length] = '\0';
+
+    bool found[LAYERS] = {false};
+    for (const char *next = strstr(text, "LAYOUT_split_3x6_3("); next != NULL;
+         next           = strstr(next, "LAYOUT_split_3x6_3(")) {
+        // The layer it's for, as in `[TYPING_0] = LAYOUT_split_3x6_3(`.
+        const char *open  = next;
+        while (open > text && *open != '[') {
+            --open;
+        }
+        int8_t layer = -1;
+        for (uint8_t i = 0; i < LAYERS; ++i) {
+            size_t size = strlen(names[i]);
+            if (strncmp(open + 1, names[i], size) == 0 && open[size + 1] == ']') {
+                layer = i;
+            }
+        }
+        if (layer < 0) {
+            fprintf(stderr, "%s: LAYOUT_split_3x6_3 for an unknown layer\n", path);
+            return false;
+        }
+
+        next += strlen("LAYOUT_split_3x6_3(");
+
+        uint8_t key = 0, depth = 0, size = 0;
+        for (; *next != '\0' && !(depth == 0 && *next == ')'); ++next) {
+            if (next[0] == '/' && next[1] == '/') {
+                next = strchr(next, '\n');
+                if (next == NULL) {
+                    break;
+                }
+            } else if (depth == 0 && *next == ',') {
+                ++key;
+                size = 0;
+            } else if (!isspace((unsigned char)*next)) {
+                depth += *next == '(';
+                depth -= *next == ')';
+                if (key >= LAYOUT_KEYS || size >= sizeof(keys[layer][key]) - 1) {
+                    fprintf(stderr, "%s: too many or too long keys for %s\n", path, names[layer]);
+                    return false;
+                }
+                keys[layer][key][size++] = *next;
+            }
+        }
+        if (key != LAYOUT_KEYS - 1) {
+            fprintf(stderr, "%s: %u keys for %s, expected %u\n", path, key + 1, names[layer], LAYOUT_KEYS);
+            return false;
+        }
+        found[layer] = true;
+    }
+
+    for (uint8_t i = 0; i < LAYERS; ++i) {
+        if (!found[i]) {
+            fprintf(stderr, "%s: no LAYOUT_split_3x6_3 for %s\n", path, names[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static const char *licence[] = {
+    "This program is free software: you can redistribute it and/or modify it under the terms of the GNU General",
+    "Public License as published by the Free Software Foundation, either version 3 of the License, or (at your",
+    "option) any later version.",
+    "",
+    "This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the",
+    "implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License",
+    "for more details.",
+    "",
+    "You should have received a copy of the GNU General Public License along with this program. If not, see",
+    "<http://www.gnu.org/licenses/>.",
+};
+
+static void print_rule(char first, char last) {
+    putchar(first);
+    for (uint8_t i = 0; i < 111; ++i) {
+        putchar('*');
+    }
+    printf("%c\n", last);
+}
+
+static void print_banner(void) {
+    print_rule('/', '\\');
+    printf("* %-109s *\n", "Flattened keymap, GENERATED by sim/flatten.c from keymaps[] (see keymap.c).");
+    printf("* %-109s *\n", "Don't edit by hand, run `make -C sim flat` after changing the keymap instead.");
+    printf("* %-109s *\n", "");
+    printf("* %-109s *\n", "Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>");
+    printf("* %-109s *\n", "");
+    for (size_t i = 0; i < sizeof(licence) / sizeof(licence[0]); ++i) {
+        printf("* %-109s *\n", licence[i]);
+    }
+    print_rule('\\', '/');
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <keymap.c>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!parse(argv[1])) {
+        return EXIT_FAILURE;
+    }
+
+    print_banner();
+    printf("\n");
+    printf("#pragma once\n");
+    printf("\n");
+    printf("// Every layer as seen when it's the top one, i.e., with its transparent keys already resolved over "
+           "the layers\n");
+    printf("// it's stacked on. Indexed the same as keymaps[], & included right after it.\n");
+    printf("\n");
+    printf("// clang-format off\n");
+    printf("static const uint16_t keymaps_flat[][MATRIX_ROWS][MATRIX_COLS] PROGMEM = {\n");
+    for (uint8_t layer = 0; layer < LAYERS; ++layer) {
+        printf("    [%s] = {\n", names[layer]);
+        for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+            printf("        {");
+            for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+                uint8_t     key  = layout[row][col];
+                const char *name = key ? keys[source(stack(layer), row, col)][key - 1] : "KC_NO";
+                if (col < MATRIX_COLS - 1) {
+                    printf("%s,%*s", name, (int)(14 - strlen(name)), "");
+                } else {
+                    printf("%s", name);
+                }
+            }
+            printf("},\n");
+        }
+        printf("    },\n");
+    }
+    printf("};\n");
+    printf("// clang-format on\n");
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(void) {
+    unsigned failures = 0;
+
+    for (uint8_t layer = 0; layer < LAYERS; ++layer) {
+        layer_state_t layers = stack(layer);
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+            for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+                keypos_t key = {.row = row, .col = col};
+
+                // Same walk as QMK, but through keymap_key_to_keycode (i.e., the flattened keymap).
+                uint16_t keycode = KC_TRNS;
+                uint32_t reads   = sim_pgm_reads;
+                for (int8_t i = 31; i >= 0 && keycode == KC_TRNS; --i) {
+                    if (layers & (1UL << i)) {
+                        keycode = keymap_key_to_keycode(i, key);
+                    }
+                }
+                reads = sim_pgm_reads - reads;
+
+                uint16_t expected = resolve(layers, row, col);
+                if (keycode != expected || (reads > 1 && expected != KC_TRNS)) {
+                    fprintf(stderr, "%s (%u, %u): got 0x%04X after %u reads from flash, expected 0x%04X\n",
+                            names[layer], row, col, keycode, reads, expected);
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    // Anything off the matrix or above the last layer is no key, same as QMK's own lookup.
+    keypos_t outside[] = {{.row = MATRIX_ROWS, .col = 0}, {.row = 0, .col = MATRIX_COLS}};
+    for (uint8_t i = 0; i < sizeof(outside) / sizeof(outside[0]); ++i) {
+        if (keymap_key_to_keycode(TYPING_0, outside[i]) != KC_NO) {
+            fprintf(stderr, "(%u, %u): not KC_NO, even though it's off the matrix\n", outside[i].row,
+                    outside[i].col);
+            ++failures;
+        }
+    }
+    if (keymap_key_to_keycode(LAYERS, (keypos_t){.row = 0, .col = 0}) != KC_NO) {
+        fprintf(stderr, "Layer %u: not KC_NO, even though there's no such layer\n", LAYERS);
+        ++failures;
+    }
+
+    if (failures > 0) {
+        fprintf(stderr, "Flat keymap is out of date or slow (%u mismatches), run `make -C sim flat`\n",
+                failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("Flat keymap: %u layers x %u keys, all match keymaps[] in a single read from flash\n", LAYERS,
+           MATRIX_ROWS * MATRIX_COLS);
+    return EXIT_SUCCESS;
+}
+
+#endif // FLAT_KEYMAP_ENABLE
+
+///////////////////////////////////////////////////// Hooks /////////////////////////////////////////////////////
+// Nothing gets replayed.
+
+void sim_on_event(uint8_t row, uint8_t col, bool pressed) {}
+void sim_on_record(uint16_t keycode, const keyrecord_t *record, uint64_t elapsed_ns) {}
+void sim_on_tap_resolved(uint16_t keycode, const keyrecord_t *record, bool hold, uint16_t delay, uint16_t term) {}
+void sim_on_report(const report_keyboard_t *report) {}
+void sim_on_consumer(uint8_t keycode, bool pressed) {}
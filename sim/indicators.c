@@ -0,0 +1,101 @@
+/***************************************************************************************************************\
+* Indicator tables, checked against keymaps[] (see indicators.h & keymap.c).                                    *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Usage: indicators
+//
+// Goes through every LED in every indicator table and checks it against the key it sits under (through the same
+// g_led_config the firmware uses) in keymaps[]. On top of the first layer of each mode the tables highlight
+// whatever they want, but on any other layer a key lights up if & only if it isn't transparent, and mode switches
+// (TO) & nothing else in the mode colour. The underglow is in the gaming colour while gaming, & left be otherwise.
+// It fails if any of them differs, or if a colour isn't in the palette.
+
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INDICATORS_TABLES
+#include "indicators.h"
+
+#define LAYERS (GAMING_1 + 1)
+#define COLOURS (sizeof(indicators_palette) / sizeof(indicators_palette[0]))
+
+_Static_assert(sizeof(indicators) / sizeof(indicators[0]) == LAYERS, "An indicator table per layer");
+
+static const char *names[LAYERS] = {
+    [TYPING_0] = "TYPING_0", [TYPING_1] = "TYPING_1", [TYPING_2] = "TYPING_2",
+    [GAMING_0] = "GAMING_0", [GAMING_1] = "GAMING_1",
+};
+
+static unsigned failures = 0;
+
+static void fail(uint8_t layer, uint8_t led, const char *what, uint8_t colour) {
+    fprintf(stderr, "%s LED %u: %s, but got colour %u\n", names[layer], led, what, colour);
+    ++failures;
+}
+
+int main(void) {
+    for (uint8_t layer = 0; layer < LAYERS; ++layer) {
+        bool gaming = IS_GAMING(1UL << layer);
+        bool first  = layer == TYPING_0 || layer == GAMING_0;
+
+        for (uint8_t led = 0; led < DRIVER_LED_TOTAL; ++led) {
+            uint8_t colour = pgm_read_byte(&indicators[layer][led]);
+            if (colour >= COLOURS) {
+                fail(layer, led, "not in the palette", colour);
+            } else if (g_led_config.flags[led] & LED_FLAG_UNDERGLOW && colour != (gaming ? GAM : ___)) {
+                fail(layer, led, gaming ? "underglow while gaming" : "underglow while typing", colour);
+            }
+        }
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+            for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+                uint8_t led = g_led_config.matrix_co[row][col];
+                if (led == NO_LED || first) {
+                    continue;
+                }
+
+                uint16_t keycode = pgm_read_word(&keymaps[layer][row][col]);
+                uint8_t  colour  = pgm_read_byte(&indicators[layer][led]);
+                if (keycode == KC_TRNS && colour != ___) {
+                    fail(layer, led, "transparent key", colour);
+                } else if (keycode != KC_TRNS && colour == ___) {
+                    fail(layer, led, "key not highlighted", colour);
+                } else if ((keycode >= QK_TO && keycode <= QK_TO_MAX) != (colour == MOD)) {
+                    fail(layer, led, colour == MOD ? "not a mode switch" : "mode switch", colour);
+                }
+            }
+        }
+    }
+
+    if (failures > 0) {
+        fprintf(stderr, "Indicators are out of date (%u mismatches), update indicators.h\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("Indicators: %u layers x %u LEDs, all match keymaps[]\n", LAYERS, DRIVER_LED_TOTAL);
+    return EXIT_SUCCESS;
+}
+
+///////////////////////////////////////////////////// Hooks /////////////////////////////////////////////////////
+// Nothing gets replayed.
+
+void sim_on_event(uint8_t row, uint8_t col, bool pressed) {}
+void sim_on_record(uint16_t keycode, const keyrecord_t *record, uint64_t elapsed_ns) {}
+void sim_on_tap_resolved(uint16_t keycode, const keyrecord_t *record, bool hold, uint16_t delay, uint16_t term) {}
+void sim_on_report(const report_keyboard_t *report) {}
+void sim_on_consumer(uint8_t keycode, bool pressed) {}
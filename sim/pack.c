@@ -0,0 +1,288 @@
+/***************************************************************************************************************\
+* Packed snippets, generated from snippets.h or checked against it.                                             *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Usage: pack
+//
+// Built without PACK_CHECK, it prints snippets_packed.h: the text of every snippet in snippets.h, as the keys to
+// press for it & then byte-pair encoded (see snippets.h), along with how deep the pairs nest so that the firmware
+// knows how much it needs to unpack them.
+//
+// Built with it, it unpacks every snippet from snippets_packed.h the same way the firmware does, and checks that
+// it types exactly the text in snippets.h. It fails if any of them differs.
+
+#include "quantum.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SNIPPETS_TEXT
+#include "snippets.h"
+
+#define PAIRS (0x100 - SNIPPET_PAIR - 1) // SNIPPET_DONE can't be used.
+
+// Keys for each character on an en-US layout, with SNIPPET_SHIFT for the ones that need it.
+static uint8_t ascii[128] = {
+    ['\t'] = KC_TAB, ['\n'] = KC_ENT, [' '] = KC_SPC,
+
+    ['a'] = KC_A, ['b'] = KC_B, ['c'] = KC_C, ['d'] = KC_D, ['e'] = KC_E, ['f'] = KC_F, ['g'] = KC_G,
+    ['h'] = KC_H, ['i'] = KC_I, ['j'] = KC_J, ['k'] = KC_K, ['l'] = KC_L, ['m'] = KC_M, ['n'] = KC_N,
+    ['o'] = KC_O, ['p'] = KC_P, ['q'] = KC_Q, ['r'] = KC_R, ['s'] = KC_S, ['t'] = KC_T, ['u'] = KC_U,
+    ['v'] = KC_V, ['w'] = KC_W, ['x'] = KC_X, ['y'] = KC_Y, ['z'] = KC_Z,
+
+    ['1'] = KC_1, ['2'] = KC_2, ['3'] = KC_3, ['4'] = KC_4, ['5'] = KC_5,
+    ['6'] = KC_6, ['7'] = KC_7, ['8'] = KC_8, ['9'] = KC_9, ['0'] = KC_0,
+
+    ['!'] = SNIPPET_SHIFT | KC_1, ['@'] = SNIPPET_SHIFT | KC_2, ['#'] = SNIPPET_SHIFT | KC_3,
+    ['$'] = SNIPPET_SHIFT | KC_4, ['%'] = SNIPPET_SHIFT | KC_5, ['^'] = SNIPPET_SHIFT | KC_6,
+    ['&'] = SNIPPET_SHIFT | KC_7, ['*'] = SNIPPET_SHIFT | KC_8, ['('] = SNIPPET_SHIFT | KC_9,
+    [')'] = SNIPPET_SHIFT | KC_0,
+
+    ['-'] = KC_MINS, ['_'] = SNIPPET_SHIFT | KC_MINS, ['='] = KC_EQL,  ['+'] = SNIPPET_SHIFT | KC_EQL,
+    ['['] = KC_LBRC, ['{'] = SNIPPET_SHIFT | KC_LBRC, [']'] = KC_RBRC, ['}'] = SNIPPET_SHIFT | KC_RBRC,
+    [';'] = KC_SCLN, [':'] = SNIPPET_SHIFT | KC_SCLN, ['\''] = KC_QUOT, ['"'] = SNIPPET_SHIFT | KC_QUOT,
+    [','] = KC_COMM, ['<'] = SNIPPET_SHIFT | KC_COMM, ['.'] = KC_DOT,  ['>'] = SNIPPET_SHIFT | KC_DOT,
+    ['/'] = KC_SLSH, ['?'] = SNIPPET_SHIFT | KC_SLSH, ['`'] = KC_GRV,  ['~'] = SNIPPET_SHIFT | KC_GRV,
+    ['\\'] = KC_BSLS, ['|'] = SNIPPET_SHIFT | KC_BSLS,
+};
+
+// Initialised below, upper case letters are the lower case ones with shift.
+static void ascii_init(void) {
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        ascii[(uint8_t)c] = SNIPPET_SHIFT | ascii[c - 'A' + 'a'];
+    }
+}
+
+#ifndef PACK_CHECK
+
+typedef struct {
+    uint8_t *bytes;
+    size_t   length;
+} sequence_t;
+
+static sequence_t sequences[SNIPPETS_COUNT];
+static uint8_t    pairs[PAIRS][2];
+static uint8_t    depths[0x100]; // How many pairs deep each byte goes, 0 for keys.
+static size_t     pairs_count = 0;
+
+static void print_rule(char first, char last) {
+    putchar(first);
+    for (uint8_t i = 0; i < 111; ++i) {
+        putchar('*');
+    }
+    printf("%c\n", last);
+}
+
+static void print_banner(void) {
+    print_rule('/', '\\');
+    printf("* %-109s *\n", "Packed snippets, GENERATED by sim/pack.c from snippets.h.");
+    printf("* %-109s *\n", "Don't edit by hand, run `make -C sim pack` after changing the snippets instead.");
+    printf("* %-109s *\n", "");
+    printf("* %-109s *\n", "Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>");
+    printf("* %-109s *\n", "");
+    // Same licence as the rest of the repo, which is conveniently one of the snippets.
+    for (const char *line = snippets_text[SNIPPET_LICENCE]; *line != '\0';) {
+        int length = strchr(line, '\n') - line;
+        printf("* %-109.*s *\n", length, line);
+        line += length + 1;
+    }
+    print_rule('\\', '/');
+}
+
+// Replaces the most common pair of bytes with a new one, if that saves any space.
+static bool pack_pair(void) {
+    static uint16_t counts[0x100][0x100];
+    memset(counts, 0, sizeof(counts));
+
+    uint16_t best = 0;
+    uint8_t  first = 0, second = 0;
+    for (size_t i = 0; i < SNIPPETS_COUNT; ++i) {
+        sequence_t *sequence = &sequences[i];
+        for (size_t j = 0; j + 1 < sequence->length; ++j) {
+            uint8_t a = sequence->bytes[j], b = sequence->bytes[j + 1];
+            if (a == b && j + 2 < sequence->length && sequence->bytes[j + 2] == a) {
+                ++j; // Runs only get replaced every other byte.
+            }
+            if (++counts[a][b] > best) {
+                best   = counts[a][b];
+                first  = a;
+                second = b;
+            }
+        }
+    }
+
+    // Each replacement saves a byte, and the pair itself takes 2.
+    if (best <= 2 || pairs_count == PAIRS) {
+        return false;
+    }
+
+    uint8_t pair = SNIPPET_PAIR + pairs_count;
+    pairs[pairs_count][0] = first;
+    pairs[pairs_count][1] = second;
+    depths[pair]          = 1 + (depths[first] > depths[second] ? depths[first] : depths[second]);
+    ++pairs_count;
+
+    for (size_t i = 0; i < SNIPPETS_COUNT; ++i) {
+        sequence_t *sequence = &sequences[i];
+        size_t      length   = 0;
+        for (size_t j = 0; j < sequence->length; ++j) {
+            if (j + 1 < sequence->length && sequence->bytes[j] == first && sequence->bytes[j + 1] == second) {
+                sequence->bytes[length++] = pair;
+                ++j;
+            } else {
+                sequence->bytes[length++] = sequence->bytes[j];
+            }
+        }
+        sequence->length = length;
+    }
+
+    return true;
+}
+
+int main(void) {
+    ascii_init();
+
+    size_t characters = 0;
+    for (size_t i = 0; i < SNIPPETS_COUNT; ++i) {
+        const char *text = snippets_text[i];
+        size_t      length = strlen(text);
+
+        sequences[i] = (sequence_t){.bytes = malloc(length), .length = length};
+        for (size_t j = 0; j < length; ++j) {
+            uint8_t c = text[j];
+            if (c >= sizeof(ascii) || ascii[c] == KC_NO) {
+                fprintf(stderr, "Snippet %zu: can't type 0x%02X\n", i, c);
+                return EXIT_FAILURE;
+            }
+            sequences[i].bytes[j] = ascii[c];
+        }
+        characters += length;
+    }
+
+    while (pack_pair()) {
+    }
+
+    uint8_t depth = 0;
+    for (size_t i = 0; i < pairs_count; ++i) {
+        depth = depths[SNIPPET_PAIR + i] > depth ? depths[SNIPPET_PAIR + i] : depth;
+    }
+    size_t bytes = 0;
+    for (size_t i = 0; i < SNIPPETS_COUNT; ++i) {
+        bytes += sequences[i].length;
+    }
+
+    print_banner();
+    printf("\n");
+    printf("#pragma once\n");
+    printf("\n");
+    printf("// %zu characters packed into %zu bytes.\n", characters, 2 * pairs_count + bytes);
+    printf("\n");
+    printf("// Bytes waiting to be unpacked at most, i.e., how deep pairs nest plus one.\n");
+    printf("#define SNIPPETS_STACK %u\n", depth + 1);
+    printf("\n");
+    printf("// clang-format off\n");
+    printf("static const uint8_t snippets_pairs[][2] PROGMEM = {\n");
+    for (size_t i = 0; i < pairs_count; ++i) {
+        printf("    {0x%02X, 0x%02X}, // 0x%02zX\n", pairs[i][0], pairs[i][1], SNIPPET_PAIR + i);
+    }
+    if (pairs_count == 0) {
+        printf("    {0x00, 0x00}, // Unused.\n");
+    }
+    printf("};\n");
+    printf("\n");
+    printf("static const uint16_t snippets_offsets[SNIPPETS_COUNT + 1] PROGMEM = {");
+    size_t offset = 0;
+    for (size_t i = 0; i < SNIPPETS_COUNT; ++i) {
+        printf("%zu, ", offset);
+        offset += sequences[i].length;
+    }
+    printf("%zu};\n", offset);
+    printf("\n");
+    printf("static const uint8_t snippets_data[] PROGMEM = {\n");
+    for (size_t i = 0; i < SNIPPETS_COUNT; ++i) {
+        for (size_t j = 0; j < sequences[i].length; ++j) {
+            printf("%s0x%02X,%s", j % 16 ? " " : "    ", sequences[i].bytes[j],
+                   j % 16 == 15 || j + 1 == sequences[i].length ? "\n" : "");
+        }
+    }
+    printf("};\n");
+    printf("// clang-format on\n");
+
+    return EXIT_SUCCESS;
+}
+
+#else // PACK_CHECK
+
+#include "snippets_packed.h"
+
+int main(void) {
+    ascii_init();
+
+    // Keys back into characters.
+    char keys[0x80] = {0};
+    for (size_t c = 0; c < sizeof(ascii); ++c) {
+        if (ascii[c] != KC_NO) {
+            keys[ascii[c]] = c;
+        }
+    }
+
+    unsigned failures = 0;
+    size_t   characters = 0;
+    for (size_t i = 0; i < SNIPPETS_COUNT; ++i) {
+        const char *text   = snippets_text[i];
+        size_t      length = 0;
+        bool        match  = true;
+
+        // Same as the firmware, see macros.h.
+        uint8_t  stack[SNIPPETS_STACK];
+        uint8_t  depth = 0;
+        uint16_t next  = pgm_read_word(&snippets_offsets[i]);
+        uint16_t end   = pgm_read_word(&snippets_offsets[i + 1]);
+        while (depth > 0 || next < end) {
+            uint8_t byte = depth > 0 ? stack[--depth] : pgm_read_byte(&snippets_data[next++]);
+            if (byte >= SNIPPET_PAIR) {
+                if (depth + 2 > SNIPPETS_STACK) {
+                    fprintf(stderr, "Snippet %zu: SNIPPETS_STACK is too small\n", i);
+                    return EXIT_FAILURE;
+                }
+                stack[depth++] = pgm_read_byte(&snippets_pairs[byte - SNIPPET_PAIR][1]);
+                stack[depth++] = pgm_read_byte(&snippets_pairs[byte - SNIPPET_PAIR][0]);
+                continue;
+            }
+
+            match = match && text[length] != '\0' && keys[byte] == text[length];
+            ++length;
+        }
+
+        if (!match || length != strlen(text)) {
+            fprintf(stderr, "Snippet %zu doesn't match snippets.h\n", i);
+            ++failures;
+        }
+        characters += length;
+    }
+
+    if (failures > 0) {
+        fprintf(stderr, "Packed snippets are out of date (%u mismatches), run `make -C sim pack`\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("Snippets: %u snippets, %zu characters packed into %zu bytes, all match snippets.h\n", SNIPPETS_COUNT,
+           characters, sizeof(snippets_pairs) + sizeof(snippets_data));
+    return EXIT_SUCCESS;
+}
+
+#endif // PACK_CHECK
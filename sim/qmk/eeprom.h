@@ -0,0 +1,38 @@
+/***************************************************************************************************************\
+* EEPROM interface, as in tmk_core/common/eeprom.h.                                                             *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Last address, as given by avr/io.h for the ATmega32U4 (1KB).
+#define E2END 0x3FF
+
+// How long writing a byte takes, as in the ATmega32U4 datasheet (3.4ms, rounded up). Reads & writes done before
+// then wait for it, as avr-libc's do.
+#define EEPROM_WRITE_MS 4
+
+bool    sim_eeprom_is_ready(void);
+uint8_t eeprom_read_byte(const uint8_t *address);
+void    eeprom_update_byte(uint8_t *address, uint8_t value);
+void    eeprom_read_block(void *destination, const void *source, size_t size);
+void    eeprom_update_block(const void *source, void *destination, size_t size);
+
+// A macro, as in avr/eeprom.h.
+#define eeprom_is_ready() sim_eeprom_is_ready()
@@ -0,0 +1,580 @@
+/***************************************************************************************************************\
+* Minimal host-side stand-in for the parts of QMK used by the keymap.                                           *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// The tapping logic follows quantum/action_tapping.c for a single dual-role key at a time, with TAPPING_TERM,
+// TAPPING_TERM_PER_KEY and PERMISSIVE_HOLD taken from the keymap's config.h. Tap dance, one shot keys, et cetera
+// are left out since the keymap does not use them.
+
+#include "sim.h"
+
+#include "debounce.h"
+
+#include <string.h>
+#include <time.h>
+
+uint32_t sim_time = 0;
+
+////////////////////////////////////////////////////// Timer ////////////////////////////////////////////////////
+
+uint16_t timer_read(void) {
+    return sim_time & 0xFFFF;
+}
+
+uint32_t timer_read32(void) {
+    return sim_time;
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(timer_read(), last);
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return sim_time - last;
+}
+
+////////////////////////////////////////////////////// EEPROM ///////////////////////////////////////////////////
+
+uint8_t  sim_eeprom[E2END + 1] = {[0 ... E2END] = 0xFF};
+uint32_t sim_eeprom_writes[E2END + 1];
+uint32_t sim_eeprom_waits = 0;
+
+static uint32_t eeprom_busy_until = 0;
+
+bool sim_eeprom_is_ready(void) {
+    return sim_time >= eeprom_busy_until;
+}
+
+// Waits for the last write to finish. Time doesn't move within a pass, so the wait is only counted, & the next
+// write starts right after it.
+static uint32_t eeprom_wait(void) {
+    static uint32_t waited_until = 0;
+
+    uint32_t start = sim_time > waited_until ? sim_time : waited_until;
+    if (eeprom_busy_until > start) {
+        sim_eeprom_waits += eeprom_busy_until - start;
+        waited_until = eeprom_busy_until;
+    }
+    return eeprom_busy_until > sim_time ? eeprom_busy_until : sim_time;
+}
+
+uint8_t eeprom_read_byte(const uint8_t *address) {
+    eeprom_wait();
+    return sim_eeprom[(uintptr_t)address];
+}
+
+void eeprom_update_byte(uint8_t *address, uint8_t value) {
+    uint32_t now = eeprom_wait();
+    if (sim_eeprom[(uintptr_t)address] != value) {
+        sim_eeprom[(uintptr_t)address] = value;
+        ++sim_eeprom_writes[(uintptr_t)address];
+        eeprom_busy_until = now + EEPROM_WRITE_MS;
+    }
+}
+
+void eeprom_read_block(void *destination, const void *source, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        ((uint8_t *)destination)[i] = eeprom_read_byte((const uint8_t *)source + i);
+    }
+}
+
+void eeprom_update_block(const void *source, void *destination, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        eeprom_update_byte((uint8_t *)destination + i, ((const uint8_t *)source)[i]);
+    }
+}
+
+////////////////////////////////////////////////////// Split ////////////////////////////////////////////////////
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+bool is_keyboard_left(void) {
+    return true;
+}
+
+////////////////////////////////////////////////////// Layers ///////////////////////////////////////////////////
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 1;
+
+__attribute__((weak)) layer_state_t layer_state_set_user(layer_state_t state) {
+    return state;
+}
+
+static void layer_state_set(layer_state_t state) {
+    layer_state = layer_state_set_user(state);
+}
+
+void layer_on(uint8_t layer) {
+    layer_state_set(layer_state | ((layer_state_t)1 << layer));
+}
+
+void layer_off(uint8_t layer) {
+    layer_state_set(layer_state & ~((layer_state_t)1 << layer));
+}
+
+void layer_move(uint8_t layer) {
+    layer_state_set((layer_state_t)1 << layer);
+}
+
+uint8_t get_highest_layer(layer_state_t state) {
+    uint8_t layer = 0;
+    for (uint8_t i = 0; i < 32; ++i) {
+        if (state & ((layer_state_t)1 << i)) {
+            layer = i;
+        }
+    }
+    return layer;
+}
+
+/////////////////////////////////////////////////////// HID /////////////////////////////////////////////////////
+
+static report_keyboard_t keyboard_report;
+
+static void sim_send_keyboard(report_keyboard_t *report) {
+    sim_on_report(report);
+}
+
+// Only set once the keyboard is up (see sim_init).
+static host_driver_t  sim_driver  = {.send_keyboard = sim_send_keyboard};
+static host_driver_t *host_driver = NULL;
+
+host_driver_t *host_get_driver(void) {
+    return host_driver;
+}
+
+void host_set_driver(host_driver_t *driver) {
+    host_driver = driver;
+}
+
+void send_keyboard_report(void) {
+    if (host_driver != NULL) {
+        host_driver->send_keyboard(&keyboard_report);
+    }
+}
+
+uint8_t get_mods(void) {
+    return keyboard_report.mods;
+}
+
+void set_mods(uint8_t mods) {
+    keyboard_report.mods = mods;
+}
+
+void clear_mods(void) {
+    keyboard_report.mods = 0;
+}
+
+void add_key(uint8_t kc) {
+    int free = -1;
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; ++i) {
+        if (keyboard_report.keys[i] == kc) {
+            return;
+        }
+        if (free < 0 && keyboard_report.keys[i] == KC_NO) {
+            free = i;
+        }
+    }
+    if (free >= 0) {
+        keyboard_report.keys[free] = kc;
+    } // Else roll over.
+}
+
+void del_key(uint8_t kc) {
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; ++i) {
+        if (keyboard_report.keys[i] == kc) {
+            keyboard_report.keys[i] = KC_NO;
+        }
+    }
+}
+
+void register_code(uint8_t kc) {
+    if (kc == KC_NO || kc == KC_TRNS) {
+        return;
+    }
+
+    if (IS_CONSUMER(kc)) {
+        sim_on_consumer(kc, true);
+        return;
+    }
+
+    if (IS_MOD(kc)) {
+        keyboard_report.mods |= MOD_BIT(kc);
+    } else {
+        add_key(kc);
+    }
+
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t kc) {
+    if (kc == KC_NO || kc == KC_TRNS) {
+        return;
+    }
+
+    if (IS_CONSUMER(kc)) {
+        sim_on_consumer(kc, false);
+        return;
+    }
+
+    if (IS_MOD(kc)) {
+        keyboard_report.mods &= ~MOD_BIT(kc);
+    } else {
+        del_key(kc);
+    }
+
+    send_keyboard_report();
+}
+
+void tap_code(uint8_t kc) {
+    register_code(kc);
+    unregister_code(kc);
+}
+
+///////////////////////////////////////////////////// Keymap ////////////////////////////////////////////////////
+
+__attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    return pgm_read_word(&keymaps[layer][key.row][key.col]);
+}
+
+static uint8_t source_layers[MATRIX_ROWS][MATRIX_COLS];
+
+static uint8_t layer_switch_get_layer(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t i = 31; i >= 0; --i) {
+        if (layers & ((layer_state_t)1 << i) && keymap_key_to_keycode(i, key) != KC_TRNS) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+static uint16_t get_record_keycode(keyrecord_t *record, bool update_cache) {
+    keypos_t key = record->event.key;
+    if (!record->event.pressed) {
+        return keymap_key_to_keycode(source_layers[key.row][key.col], key);
+    }
+
+    uint8_t layer = layer_switch_get_layer(key);
+    if (update_cache) {
+        source_layers[key.row][key.col] = layer;
+    }
+    return keymap_key_to_keycode(layer, key);
+}
+
+///////////////////////////////////////////////////// Actions ///////////////////////////////////////////////////
+
+static void process_action(uint16_t keycode, keyrecord_t *record) {
+    bool pressed = record->event.pressed;
+
+    if (keycode <= QK_BASIC_MAX) {
+        pressed ? register_code(keycode) : unregister_code(keycode);
+
+    } else if (keycode >= QK_LAYER_TAP && keycode <= QK_LAYER_TAP_MAX) {
+        uint8_t layer = (keycode >> 8) & 0xF;
+        if (record->tap.count > 0) {
+            pressed ? register_code(keycode & 0xFF) : unregister_code(keycode & 0xFF);
+        } else {
+            pressed ? layer_on(layer) : layer_off(layer);
+        }
+
+    } else if (keycode >= QK_TO && keycode <= QK_TO_MAX) {
+        if (pressed) {
+            layer_move(keycode & 0xF);
+        }
+
+    } else if (keycode >= QK_MOMENTARY && keycode <= QK_MOMENTARY_MAX) {
+        pressed ? layer_on(keycode & 0xFF) : layer_off(keycode & 0xFF);
+    }
+}
+
+static void process_record(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+#ifdef RGB_MATRIX_ENABLE
+    process_rgb_matrix(record->event.key.row, record->event.key.col, record->event.pressed);
+#endif // RGB_MATRIX_ENABLE
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool continue_processing = process_record_user(keycode, record);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    sim_on_record(keycode, record, (end.tv_sec - start.tv_sec) * 1000000000ull + end.tv_nsec - start.tv_nsec);
+    if (continue_processing) {
+        process_action(keycode, record);
+    }
+}
+
+///////////////////////////////////////////////////// Tapping ///////////////////////////////////////////////////
+
+#define TAPPING_BUFFER_SIZE 8
+
+static keyrecord_t tapping_key;
+static bool        tapping_active = false;
+static keyrecord_t waiting_buffer[TAPPING_BUFFER_SIZE];
+static uint8_t     waiting_count = 0;
+
+static bool is_tap_record(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, false);
+    return keycode >= QK_LAYER_TAP && keycode <= QK_LAYER_TAP_MAX;
+}
+
+#ifdef TAPPING_TERM_PER_KEY
+#    define GET_TAPPING_TERM(keycode, record) get_tapping_term(keycode, record)
+#else
+#    define GET_TAPPING_TERM(keycode, record) TAPPING_TERM
+#endif // TAPPING_TERM_PER_KEY
+
+static uint16_t tapping_term(void) {
+    return GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+}
+
+static bool same_key(keypos_t a, keypos_t b) {
+    return a.row == b.row && a.col == b.col;
+}
+
+static void process_tapping(keyrecord_t *record);
+
+static void tapping_resolve(bool hold) {
+    keyrecord_t key       = tapping_key;
+    tapping_active        = false;
+    key.tap.count         = hold ? 0 : 1;
+    tapping_key.tap.count = key.tap.count;
+
+    uint16_t keycode = get_record_keycode(&key, false);
+    sim_on_tap_resolved(keycode, &key, hold, TIMER_DIFF_16(timer_read(), key.event.time),
+                        GET_TAPPING_TERM(keycode, &key));
+    process_record(&key);
+
+    keyrecord_t buffer[TAPPING_BUFFER_SIZE];
+    uint8_t     count = waiting_count;
+    memcpy(buffer, waiting_buffer, sizeof(buffer));
+    waiting_count = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        process_tapping(&buffer[i]);
+    }
+}
+
+static void process_tapping(keyrecord_t *record) {
+    if (!tapping_active) {
+        if (record->event.pressed && is_tap_record(record)) {
+            tapping_key           = *record;
+            tapping_key.tap.count = 0;
+            tapping_active        = true;
+            return;
+        }
+
+        process_record(record);
+        return;
+    }
+
+    if (!record->event.pressed && same_key(record->event.key, tapping_key.event.key)) {
+        // Taken before resolving, as a key in the waiting buffer may become the next tapping key.
+        record->tap       = tapping_key.tap;
+        record->tap.count = 1;
+        tapping_resolve(false);
+        process_record(record);
+        return;
+    }
+
+    if (record->event.pressed) {
+        tapping_key.tap.interrupted = true;
+        if (waiting_count < TAPPING_BUFFER_SIZE) {
+            waiting_buffer[waiting_count++] = *record;
+        }
+        return;
+    }
+
+#ifdef PERMISSIVE_HOLD
+    for (uint8_t i = 0; i < waiting_count; ++i) {
+        if (same_key(record->event.key, waiting_buffer[i].event.key)) {
+            tapping_resolve(true);
+            process_tapping(record);
+            return;
+        }
+    }
+#endif // PERMISSIVE_HOLD
+
+    process_record(record);
+}
+
+void action_exec(keyevent_t event) {
+    keyrecord_t record = {.event = event};
+    process_tapping(&record);
+}
+
+static void tapping_task(void) {
+    if (tapping_active && TIMER_DIFF_16(timer_read(), tapping_key.event.time) >= tapping_term()) {
+        tapping_resolve(true);
+    }
+}
+
+////////////////////////////////////////////////////// Matrix ///////////////////////////////////////////////////
+
+static matrix_row_t raw_matrix[MATRIX_ROWS];
+static matrix_row_t previous_matrix[MATRIX_ROWS];
+static matrix_row_t matrix[MATRIX_ROWS];
+static bool         matrix_changed = false;
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif // DEBOUNCE
+
+// QMK's default (sym_defer_g), for keymaps that don't bring their own.
+static bool     debouncing = false;
+static uint16_t debouncing_time;
+
+__attribute__((weak)) void debounce_init(uint8_t num_rows) {}
+
+__attribute__((weak)) void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    if (changed) {
+        debouncing      = true;
+        debouncing_time = timer_read();
+    } else if (debouncing && timer_elapsed(debouncing_time) >= DEBOUNCE) {
+        memcpy(cooked, raw, num_rows * sizeof(matrix_row_t));
+        debouncing = false;
+    }
+}
+
+matrix_row_t matrix_get_row(uint8_t row) {
+    return matrix[row];
+}
+
+__attribute__((weak)) void matrix_scan_user(void) {}
+
+static void matrix_task(void) {
+    debounce(raw_matrix, matrix, MATRIX_ROWS, matrix_changed);
+    matrix_changed = false;
+    matrix_scan_user();
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        matrix_row_t delta = matrix[row] ^ previous_matrix[row];
+        for (uint8_t col = 0; delta && col < MATRIX_COLS; ++col) {
+            matrix_row_t mask = (matrix_row_t)1 << col;
+            if (!(delta & mask)) {
+                continue;
+            }
+
+            keyrecord_t record = {
+                .event =
+                    {
+                        .key     = {.col = col, .row = row},
+                        .pressed = matrix[row] & mask,
+                        .time    = timer_read(),
+                    },
+            };
+
+            previous_matrix[row] ^= mask;
+            sim_on_event(row, col, record.event.pressed);
+            process_tapping(&record);
+        }
+    }
+}
+
+////////////////////////////////////////////////////// Split ////////////////////////////////////////////////////
+// Not an actual link, just what would go over it. Follows quantum/split_common/transactions.c for what the keymap
+// has enabled: the other half's rows are read whenever their checksum changes, & everything else is sent whenever
+// it changes. On top of that, all of it is sent regardless every FORCED_SYNC_THROTTLE_MS.
+
+#ifndef FORCED_SYNC_THROTTLE_MS
+#    define FORCED_SYNC_THROTTLE_MS 100
+#endif // FORCED_SYNC_THROTTLE_MS
+
+#define SLAVE_ROWS (MATRIX_ROWS / 2)
+
+sim_split_stats_t sim_split_stats;
+
+static void split_transaction(size_t bytes) {
+    ++sim_split_stats.transactions;
+    sim_split_stats.bytes += bytes;
+}
+
+// Sent if it changed or if it's been a while, & then remembered as what the other half has.
+static void split_sync(uint32_t *last_update, void *synced, const void *current, size_t bytes) {
+    if (memcmp(synced, current, bytes) != 0 || timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS) {
+        split_transaction(bytes);
+        memcpy(synced, current, bytes);
+        *last_update = timer_read32();
+    }
+}
+
+static void split_task(void) {
+    static uint32_t     timer_update;
+    static uint32_t     matrix_update;
+    static matrix_row_t matrix_synced[SLAVE_ROWS];
+
+    // The checksum is read on every pass, the rows only when it doesn't match.
+    split_transaction(1);
+    split_sync(&matrix_update, matrix_synced, &matrix[SLAVE_ROWS], sizeof(matrix_synced));
+
+    if (timer_elapsed32(timer_update) >= FORCED_SYNC_THROTTLE_MS) {
+        split_transaction(sizeof(uint32_t)); // Timer.
+        timer_update = timer_read32();
+    }
+
+#ifdef SPLIT_LAYER_STATE_ENABLE
+    static uint32_t      layers_update;
+    static layer_state_t layers_synced[2];
+    layer_state_t        layers[2] = {layer_state, default_layer_state};
+    split_sync(&layers_update, layers_synced, layers, sizeof(layers));
+#endif // SPLIT_LAYER_STATE_ENABLE
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    static uint32_t     rgb_update;
+    static rgb_config_t rgb_synced;
+    split_sync(&rgb_update, &rgb_synced, &rgb_matrix_config, sizeof(rgb_config_t));
+#endif // RGB_MATRIX_ENABLE && RGB_MATRIX_SPLIT
+}
+
+///////////////////////////////////////////////////// Driving ///////////////////////////////////////////////////
+
+void sim_init(void) {
+    debounce_init(MATRIX_ROWS);
+    keyboard_post_init_user();
+
+    // Same as LUFA, which only sets its driver after keyboard_init (& so after keyboard_post_init_user).
+    host_set_driver(&sim_driver);
+}
+
+void sim_event(uint8_t row, uint8_t col, bool pressed) {
+    matrix_row_t mask = (matrix_row_t)1 << col;
+    if (!(raw_matrix[row] & mask) != !pressed) {
+        raw_matrix[row] ^= mask;
+        matrix_changed = true;
+    }
+}
+
+__attribute__((weak)) void housekeeping_task_user(void) {}
+
+void sim_tick(void) {
+    matrix_task();
+    split_task();
+    tapping_task();
+#ifdef RGB_MATRIX_ENABLE
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    rgb_matrix_task();
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    rgb_matrix_stats.task_ns += (end.tv_sec - start.tv_sec) * 1000000000ull + end.tv_nsec - start.tv_nsec;
+#endif // RGB_MATRIX_ENABLE
+    housekeeping_task_user();
+
+    ++sim_time;
+}
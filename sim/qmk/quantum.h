@@ -0,0 +1,208 @@
+/***************************************************************************************************************\
+* Minimal host-side stand-in for the parts of QMK used by the keymap.                                           *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Only what the keymap actually touches is provided here, trying to keep names, values and behaviour as close
+// as possible to upstream QMK (see quantum/keycodes.h, quantum/action*.c & quantum/rgb_matrix/ in the submodule).
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config.h"
+
+//////////////////////////////////////////////////// Hardware ///////////////////////////////////////////////////
+
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 6
+
+#define DRIVER_LED_TOTAL 54
+#define RGB_MATRIX_SPLIT \
+    { 27, 27 }
+
+// Reads from flash so far, so that lookups can be checked to take as many as they should (see sim/flatten.c).
+__attribute__((weak)) uint32_t sim_pgm_reads = 0;
+
+#define PROGMEM
+#define pgm_read_byte(address) (++sim_pgm_reads, *(const uint8_t *)(address))
+#define pgm_read_word(address) (++sim_pgm_reads, *(const uint16_t *)(address))
+#define pgm_read_dword(address) (++sim_pgm_reads, *(const uint32_t *)(address))
+
+typedef uint8_t matrix_row_t;
+
+//////////////////////////////////////////////////// Keycodes ///////////////////////////////////////////////////
+
+// clang-format off
+enum hid_keyboard_keycodes {
+    KC_NO = 0x00, KC_TRNS,
+    KC_A = 0x04, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENT, KC_ESC, KC_BSPC, KC_TAB, KC_SPC, KC_MINS, KC_EQL, KC_LBRC, KC_RBRC, KC_BSLS, KC_NUHS, KC_SCLN,
+    KC_QUOT, KC_GRV, KC_COMM, KC_DOT, KC_SLSH, KC_CAPS,
+    KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12,
+    KC_PSCR, KC_SLCK, KC_PAUS, KC_INS, KC_HOME, KC_PGUP, KC_DEL, KC_END, KC_PGDN, KC_RGHT, KC_LEFT, KC_DOWN,
+    KC_UP, KC_NLCK, KC_PSLS, KC_PAST, KC_PMNS, KC_PPLS, KC_PENT,
+    KC_P1, KC_P2, KC_P3, KC_P4, KC_P5, KC_P6, KC_P7, KC_P8, KC_P9, KC_P0, KC_PDOT, KC_NUBS, KC_APP,
+    KC_AGIN = 0x79, KC_UNDO, KC_CUT, KC_COPY, KC_PSTE, KC_FIND,
+
+    // Consumer page, remapped into the basic range the same way QMK does.
+    KC_MUTE = 0xA8, KC_VOLU, KC_VOLD, KC_MNXT, KC_MPRV, KC_MSTP, KC_MPLY,
+    KC_BRIU = 0xBD, KC_BRID,
+
+    KC_LCTL = 0xE0, KC_LSFT, KC_LALT, KC_LGUI, KC_RCTL, KC_RSFT, KC_RALT, KC_RGUI,
+};
+// clang-format on
+
+#define IS_MOD(kc) ((kc) >= KC_LCTL && (kc) <= KC_RGUI)
+#define IS_CONSUMER(kc) ((kc) >= KC_MUTE && (kc) <= KC_BRID)
+#define MOD_BIT(kc) (1 << ((kc)&0x7))
+
+#define MOD_MASK_CTRL (MOD_BIT(KC_LCTL) | MOD_BIT(KC_RCTL))
+#define MOD_MASK_SHIFT (MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT))
+#define MOD_MASK_ALT (MOD_BIT(KC_LALT) | MOD_BIT(KC_RALT))
+#define MOD_MASK_GUI (MOD_BIT(KC_LGUI) | MOD_BIT(KC_RGUI))
+
+enum quantum_keycodes {
+    QK_BASIC         = 0x0000,
+    QK_BASIC_MAX     = 0x00FF,
+    QK_LAYER_TAP     = 0x4000,
+    QK_LAYER_TAP_MAX = 0x4FFF,
+    QK_TO            = 0x5000,
+    QK_TO_MAX        = 0x50FF,
+    QK_MOMENTARY     = 0x5100,
+    QK_MOMENTARY_MAX = 0x51FF,
+
+    SAFE_RANGE = 0x5DA0,
+};
+
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer)&0xF) << 8) | ((kc)&0xFF))
+#define TO(layer) (QK_TO | (0x1 << 4) | ((layer)&0xF))
+#define MO(layer) (QK_MOMENTARY | ((layer)&0xFF))
+
+// clang-format off
+#define LAYOUT_split_3x6_3(                                        \
+    L00, L01, L02, L03, L04, L05, R00, R01, R02, R03, R04, R05,    \
+    L10, L11, L12, L13, L14, L15, R10, R11, R12, R13, R14, R15,    \
+    L20, L21, L22, L23, L24, L25, R20, R21, R22, R23, R24, R25,    \
+                   L30, L31, L32, R30, R31, R32                    \
+)                                                                  \
+{                                                                  \
+    { L00,   L01,   L02,   L03, L04, L05 },                        \
+    { L10,   L11,   L12,   L13, L14, L15 },                        \
+    { L20,   L21,   L22,   L23, L24, L25 },                        \
+    { KC_NO, KC_NO, KC_NO, L30, L31, L32 },                        \
+    { R05,   R04,   R03,   R02, R01, R00 },                        \
+    { R15,   R14,   R13,   R12, R11, R10 },                        \
+    { R25,   R24,   R23,   R22, R21, R20 },                        \
+    { KC_NO, KC_NO, KC_NO, R32, R31, R30 }                         \
+}
+// clang-format on
+
+///////////////////////////////////////////////////// Actions ///////////////////////////////////////////////////
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef struct {
+    keypos_t key;
+    bool     pressed;
+    uint16_t time;
+} keyevent_t;
+
+typedef struct {
+    bool    interrupted : 1;
+    uint8_t reserved : 3;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t      tap;
+} keyrecord_t;
+
+extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+
+#define MAKE_KEYEVENT(row_num, col_num, press)                                                                  \
+    ((keyevent_t){                                                                                              \
+        .key     = (keypos_t){.row = (row_num), .col = (col_num)},                                              \
+        .pressed = (press),                                                                                     \
+        .time    = (timer_read() | 1),                                                                          \
+    })
+
+// Same as a key event coming from the matrix.
+void action_exec(keyevent_t event);
+
+bool     process_record_user(uint16_t keycode, keyrecord_t *record);
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
+void keyboard_post_init_user(void);
+void housekeeping_task_user(void);
+
+void    register_code(uint8_t kc);
+void    unregister_code(uint8_t kc);
+void    tap_code(uint8_t kc);
+uint8_t get_mods(void);
+void    set_mods(uint8_t mods);
+void    clear_mods(void);
+
+// Lower level, changing the report without sending it.
+void add_key(uint8_t kc);
+void del_key(uint8_t kc);
+void send_keyboard_report(void);
+
+////////////////////////////////////////////////////// Layers ///////////////////////////////////////////////////
+
+typedef uint32_t layer_state_t;
+
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+
+void    layer_on(uint8_t layer);
+void    layer_off(uint8_t layer);
+void    layer_move(uint8_t layer);
+uint8_t get_highest_layer(layer_state_t state);
+
+////////////////////////////////////////////////////// Matrix ///////////////////////////////////////////////////
+
+// Debounced, as QMK sees it.
+matrix_row_t matrix_get_row(uint8_t row);
+
+////////////////////////////////////////////////////// Split ////////////////////////////////////////////////////
+
+// Always the left & master half, as the simulator only runs the one connected to the PC (with the whole matrix).
+bool is_keyboard_master(void);
+bool is_keyboard_left(void);
+
+////////////////////////////////////////////////////// Timer ////////////////////////////////////////////////////
+
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+
+#define TIMER_DIFF_16(a, b) ((uint16_t)((a) - (b)))
+
+/////////////////////////////////////////////////////// RGB /////////////////////////////////////////////////////
+
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif // RGB_MATRIX_ENABLE
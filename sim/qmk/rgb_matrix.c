@@ -0,0 +1,346 @@
+/***************************************************************************************************************\
+* Minimal host-side stand-in for QMK's RGB matrix.                                                              *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Mirrors the task state machine of quantum/rgb_matrix/rgb_matrix.c and the WS2812 driver (which only flushes
+// when something changed), so that frame budgets behave the same as on the board.
+
+#include "quantum.h"
+
+#include <string.h>
+
+////////////////////////////////////////////////////// Layout ///////////////////////////////////////////////////
+
+// clang-format off
+led_config_t g_led_config = { {
+    {  24,     23,     18,     17,  10,   9 },
+    {  25,     22,     19,     16,  11,   8 },
+    {  26,     21,     20,     15,  12,   7 },
+    {  NO_LED, NO_LED, NO_LED, 14,  13,   6 },
+    {  51,     50,     45,     44,  37,  36 },
+    {  52,     49,     46,     43,  38,  35 },
+    {  53,     48,     47,     42,  39,  34 },
+    {  NO_LED, NO_LED, NO_LED, 41,  40,  33 },
+}, {
+    2, 2, 2, 2, 2, 2,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    2, 2, 2, 2, 2, 2,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+} };
+// clang-format on
+
+/////////////////////////////////////////////////////// State ///////////////////////////////////////////////////
+
+rgb_config_t       rgb_matrix_config = {
+    .enable = true,
+    .mode   = RGB_MATRIX_SOLID_COLOR,
+    .hsv    = {0, 0, 0},
+    .speed  = 0x80,
+    .flags  = LED_FLAG_ALL,
+};
+last_hit_t         g_last_hit_tracker;
+uint32_t           g_rgb_timer;
+rgb_matrix_stats_t rgb_matrix_stats;
+
+static RGB  leds[DRIVER_LED_TOTAL];
+static bool leds_dirty;
+
+static enum { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_state = SYNCING;
+
+static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
+static uint8_t         rgb_last_effect   = UINT8_MAX;
+static bool            rgb_last_enable   = false;
+static uint32_t        rgb_timer_buffer;
+static uint32_t        rgb_anim_timer;
+
+//////////////////////////////////////////////////// Maths //////////////////////////////////////////////////////
+
+uint8_t scale8(uint8_t i, uint8_t scale) {
+    return ((uint16_t)i * (uint16_t)scale) >> 8;
+}
+
+uint8_t qadd8(uint8_t i, uint8_t j) {
+    uint16_t t = i + j;
+    return t > 0xFF ? 0xFF : t;
+}
+
+uint16_t scale16by8(uint16_t i, uint8_t scale) {
+    return (i * scale) >> 8;
+}
+
+RGB hsv_to_rgb(HSV hsv) {
+    RGB rgb;
+
+    if (hsv.s == 0) {
+        rgb.r = rgb.g = rgb.b = hsv.v;
+        return rgb;
+    }
+
+    uint16_t h         = hsv.h * 6;
+    uint8_t  region    = h / 255;
+    uint16_t remainder = (h * 2 - region * 510) & 0xFF;
+
+    uint8_t p = (hsv.v * (255 - hsv.s)) >> 8;
+    uint8_t q = (hsv.v * (255 - ((hsv.s * remainder) >> 8))) >> 8;
+    uint8_t t = (hsv.v * (255 - ((hsv.s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0: rgb = (RGB){hsv.v, t, p}; break;
+        case 1: rgb = (RGB){q, hsv.v, p}; break;
+        case 2: rgb = (RGB){p, hsv.v, t}; break;
+        case 3: rgb = (RGB){p, q, hsv.v}; break;
+        case 4: rgb = (RGB){t, p, hsv.v}; break;
+        default: rgb = (RGB){hsv.v, p, q}; break;
+    }
+
+    return rgb;
+}
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    return hsv_to_rgb(hsv);
+}
+
+////////////////////////////////////////////////////// Driver ///////////////////////////////////////////////////
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    ++rgb_matrix_stats.writes;
+    if (leds[index].r == red && leds[index].g == green && leds[index].b == blue) {
+        return;
+    }
+
+    leds[index] = (RGB){red, green, blue};
+    leds_dirty  = true;
+}
+
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; ++i) {
+        rgb_matrix_set_color(i, red, green, blue);
+    }
+}
+
+static void rgb_matrix_flush(void) {
+    if (leds_dirty) {
+        ++rgb_matrix_stats.flushes;
+        leds_dirty = false;
+    }
+}
+
+////////////////////////////////////////////////////// Config ///////////////////////////////////////////////////
+
+void rgb_matrix_enable_noeeprom(void) {
+    if (!rgb_matrix_config.enable) {
+        rgb_task_state = STARTING;
+    }
+    rgb_matrix_config.enable = true;
+}
+
+void rgb_matrix_disable_noeeprom(void) {
+    rgb_task_state           = SYNCING;
+    rgb_matrix_config.enable = false;
+}
+
+void rgb_matrix_mode_noeeprom(uint8_t mode) {
+    rgb_matrix_config.mode = mode < RGB_MATRIX_EFFECT_MAX ? mode : RGB_MATRIX_EFFECT_MAX - 1;
+    rgb_task_state         = STARTING;
+}
+
+void rgb_matrix_sethsv_noeeprom(uint8_t hue, uint8_t sat, uint8_t val) {
+    uint8_t limit         = RGB_MATRIX_MAXIMUM_BRIGHTNESS;
+    rgb_matrix_config.hsv = (HSV){hue, sat, val > limit ? limit : val};
+}
+
+void rgb_matrix_set_speed_noeeprom(uint8_t speed) {
+    rgb_matrix_config.speed = speed;
+}
+
+uint8_t rgb_matrix_get_mode(void) {
+    return rgb_matrix_config.mode;
+}
+
+uint8_t rgb_matrix_get_speed(void) {
+    return rgb_matrix_config.speed;
+}
+
+////////////////////////////////////////////////////// Effects //////////////////////////////////////////////////
+
+static bool rgb_matrix_none(effect_params_t *params) {
+    if (!params->init) {
+        return false;
+    }
+
+    rgb_matrix_set_color_all(0, 0, 0);
+    return false;
+}
+
+static bool SOLID_COLOR(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    RGB rgb = rgb_matrix_hsv_to_rgb(rgb_matrix_config.hsv);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
+
+static bool SOLID_REACTIVE_SIMPLE(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        uint16_t tick = max_tick;
+        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
+            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
+                tick = g_last_hit_tracker.tick[j];
+                break;
+            }
+        }
+
+        uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
+        HSV      hsv    = rgb_matrix_config.hsv;
+        hsv.v           = scale8(255 - offset, hsv.v);
+        RGB rgb         = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
+
+#ifdef RGB_MATRIX_CUSTOM_USER
+#    define RGB_MATRIX_EFFECT(name, ...)
+#    define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#    include "rgb_matrix_user.inc"
+#    undef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#    undef RGB_MATRIX_EFFECT
+#endif // RGB_MATRIX_CUSTOM_USER
+
+/////////////////////////////////////////////////////// Task ////////////////////////////////////////////////////
+
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
+#if defined(RGB_MATRIX_KEYRELEASES)
+    if (!pressed)
+#elif defined(RGB_MATRIX_KEYPRESSES)
+    if (pressed)
+#endif
+    {
+        uint8_t led = g_led_config.matrix_co[row][col];
+        if (led == NO_LED) {
+            return;
+        }
+
+        if (g_last_hit_tracker.count + 1 > LED_HITS_TO_REMEMBER) {
+            memmove(&g_last_hit_tracker.index[0], &g_last_hit_tracker.index[1], LED_HITS_TO_REMEMBER - 1);
+            memmove(&g_last_hit_tracker.tick[0], &g_last_hit_tracker.tick[1], (LED_HITS_TO_REMEMBER - 1) * 2);
+            g_last_hit_tracker.count--;
+        }
+
+        g_last_hit_tracker.index[g_last_hit_tracker.count] = led;
+        g_last_hit_tracker.tick[g_last_hit_tracker.count]  = 0;
+        g_last_hit_tracker.count++;
+    }
+}
+
+static void rgb_task_timers(void) {
+    uint32_t deltaTime = timer_elapsed32(rgb_timer_buffer);
+    rgb_timer_buffer   = timer_read32();
+    g_rgb_timer += deltaTime;
+
+    for (uint8_t i = 0; i < g_last_hit_tracker.count; ++i) {
+        if (UINT16_MAX - deltaTime < g_last_hit_tracker.tick[i]) {
+            g_last_hit_tracker.count--;
+            continue;
+        }
+        g_last_hit_tracker.tick[i] += deltaTime;
+    }
+}
+
+__attribute__((weak)) void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {}
+
+static void rgb_matrix_indicators_advanced(effect_params_t *params) {
+#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && \
+    RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+    uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
+    uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
+    if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+#else
+    uint8_t min = 0;
+    uint8_t max = DRIVER_LED_TOTAL;
+#endif
+    rgb_matrix_indicators_advanced_user(min, max);
+}
+
+static void rgb_task_render(uint8_t effect) {
+    bool rendering         = false;
+    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+
+    ++rgb_matrix_stats.renders;
+    switch (effect) {
+        case RGB_MATRIX_NONE: rendering = rgb_matrix_none(&rgb_effect_params); break;
+        case RGB_MATRIX_SOLID_COLOR: rendering = SOLID_COLOR(&rgb_effect_params); break;
+        case RGB_MATRIX_SOLID_REACTIVE_SIMPLE: rendering = SOLID_REACTIVE_SIMPLE(&rgb_effect_params); break;
+#ifdef RGB_MATRIX_CUSTOM_USER
+#    define RGB_MATRIX_EFFECT(name, ...)                                    \
+        case RGB_MATRIX_CUSTOM_##name: rendering = name(&rgb_effect_params); \
+            break;
+#    include "rgb_matrix_user.inc"
+#    undef RGB_MATRIX_EFFECT
+#endif // RGB_MATRIX_CUSTOM_USER
+        default: break;
+    }
+
+    rgb_effect_params.iter++;
+    if (!rendering) {
+        rgb_task_state = FLUSHING;
+        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
+            rgb_task_state = SYNCING;
+        }
+    }
+}
+
+void rgb_matrix_task(void) {
+    rgb_task_timers();
+
+    uint8_t effect = rgb_matrix_config.enable ? rgb_matrix_config.mode : RGB_MATRIX_NONE;
+    switch (rgb_task_state) {
+        case STARTING:
+            ++rgb_matrix_stats.frames;
+            rgb_effect_params.iter = 0;
+            rgb_anim_timer         = timer_read32();
+            rgb_task_state         = RENDERING;
+            break;
+
+        case RENDERING:
+            rgb_task_render(effect);
+            if (effect) {
+                rgb_matrix_indicators_advanced(&rgb_effect_params);
+            }
+            break;
+
+        case FLUSHING:
+            rgb_last_effect = effect;
+            rgb_last_enable = rgb_matrix_config.enable;
+            rgb_matrix_flush();
+            rgb_task_state = SYNCING;
+            break;
+
+        case SYNCING:
+            if (timer_elapsed32(rgb_anim_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) {
+                rgb_task_state = STARTING;
+            }
+            break;
+    }
+}
@@ -0,0 +1,157 @@
+/***************************************************************************************************************\
+* Minimal host-side stand-in for QMK's RGB matrix.                                                              *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////// Types ////////////////////////////////////////////////////
+
+typedef struct {
+    uint8_t h;
+    uint8_t s;
+    uint8_t v;
+} HSV;
+
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} RGB;
+
+#define NO_LED 255
+
+typedef uint8_t led_flags_t;
+
+typedef struct {
+    uint8_t     matrix_co[MATRIX_ROWS][MATRIX_COLS];
+    led_flags_t flags[DRIVER_LED_TOTAL];
+} led_config_t;
+
+extern led_config_t g_led_config;
+
+#define LED_FLAG_ALL 0xFF
+#define LED_FLAG_UNDERGLOW 0x02
+#define LED_FLAG_KEYLIGHT 0x04
+
+typedef struct {
+    uint8_t     iter;
+    led_flags_t flags;
+    bool        init;
+} effect_params_t;
+
+#if defined(RGB_MATRIX_KEYPRESSES) || defined(RGB_MATRIX_KEYRELEASES)
+#    define RGB_MATRIX_KEYREACTIVE_ENABLED
+#endif
+
+#ifndef LED_HITS_TO_REMEMBER
+#    define LED_HITS_TO_REMEMBER 8
+#endif // LED_HITS_TO_REMEMBER
+
+typedef struct {
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+} last_hit_t;
+
+extern last_hit_t g_last_hit_tracker;
+
+typedef struct {
+    bool        enable;
+    uint8_t     mode;
+    HSV         hsv;
+    uint8_t     speed;
+    led_flags_t flags;
+} rgb_config_t;
+
+extern rgb_config_t rgb_matrix_config;
+extern uint32_t     g_rgb_timer;
+
+///////////////////////////////////////////////////// Effects ///////////////////////////////////////////////////
+
+enum rgb_matrix_effects {
+    RGB_MATRIX_NONE = 0,
+    RGB_MATRIX_SOLID_COLOR,
+    RGB_MATRIX_SOLID_REACTIVE_SIMPLE,
+#ifdef RGB_MATRIX_CUSTOM_USER
+#    define RGB_MATRIX_EFFECT(name, ...) RGB_MATRIX_CUSTOM_##name,
+#    include "rgb_matrix_user.inc"
+#    undef RGB_MATRIX_EFFECT
+#endif // RGB_MATRIX_CUSTOM_USER
+    RGB_MATRIX_EFFECT_MAX
+};
+
+#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && \
+    RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#    define RGB_MATRIX_USE_LIMITS(min, max)                        \
+        uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
+        uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;          \
+        if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+#else
+#    define RGB_MATRIX_USE_LIMITS(min, max) \
+        uint8_t min = 0;                    \
+        uint8_t max = DRIVER_LED_TOTAL;
+#endif
+
+#define RGB_MATRIX_TEST_LED_FLAGS() \
+    if (!(g_led_config.flags[i] & params->flags)) continue
+
+//////////////////////////////////////////////////// Functions //////////////////////////////////////////////////
+
+void rgb_matrix_task(void);
+void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+
+void rgb_matrix_enable_noeeprom(void);
+void rgb_matrix_disable_noeeprom(void);
+void rgb_matrix_mode_noeeprom(uint8_t mode);
+void rgb_matrix_sethsv_noeeprom(uint8_t hue, uint8_t sat, uint8_t val);
+void rgb_matrix_set_speed_noeeprom(uint8_t speed);
+uint8_t rgb_matrix_get_mode(void);
+uint8_t rgb_matrix_get_speed(void);
+
+RGB     hsv_to_rgb(HSV hsv);
+RGB     rgb_matrix_hsv_to_rgb(HSV hsv);
+uint8_t scale8(uint8_t i, uint8_t scale);
+uint8_t qadd8(uint8_t i, uint8_t j);
+
+uint16_t scale16by8(uint16_t i, uint8_t scale);
+
+#define rgblight_enable_noeeprom rgb_matrix_enable_noeeprom
+#define rgblight_disable_noeeprom rgb_matrix_disable_noeeprom
+#define rgblight_mode_noeeprom rgb_matrix_mode_noeeprom
+#define rgblight_sethsv_noeeprom rgb_matrix_sethsv_noeeprom
+#define rgblight_set_speed_noeeprom rgb_matrix_set_speed_noeeprom
+#define rgblight_get_mode rgb_matrix_get_mode
+#define rgblight_get_speed rgb_matrix_get_speed
+
+///////////////////////////////////////////////// Instrumentation ///////////////////////////////////////////////
+// Not part of QMK, these let the simulator report what the lighting costs.
+
+typedef struct {
+    uint32_t frames;  // Frames started.
+    uint32_t renders; // Effect calls (i.e., render iterations).
+    uint32_t writes;  // Calls to rgb_matrix_set_color.
+    uint32_t flushes; // Flushes that actually pushed data to the LEDs.
+    uint64_t task_ns; // Host time spent in rgb_matrix_task.
+} rgb_matrix_stats_t;
+
+extern rgb_matrix_stats_t rgb_matrix_stats;
@@ -0,0 +1,66 @@
+/***************************************************************************************************************\
+* Simulator interface, the glue between the QMK stand-in and the tools driving it.                              *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+#pragma once
+
+#include "quantum.h"
+
+#include "eeprom.h"
+#include "host.h"
+
+// Simulated time in ms, only ever moved forward by sim_tick.
+extern uint32_t sim_time;
+
+// What would have gone over the link to the other half.
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes; // Payload only.
+} sim_split_stats_t;
+
+extern sim_split_stats_t sim_split_stats;
+
+// EEPROM contents (blank, i.e. all 0xFF, unless loaded beforehand) & how many times each byte was written.
+extern uint8_t  sim_eeprom[E2END + 1];
+extern uint32_t sim_eeprom_writes[E2END + 1];
+extern uint32_t sim_eeprom_waits; // ms spent waiting for writes to finish.
+
+//////////////////////////////////////////////////// Driving ////////////////////////////////////////////////////
+
+// Power up the keyboard (i.e., runs the keymap's init hooks).
+void sim_init(void);
+
+// A change in the raw matrix, which goes through debouncing on the next tick.
+void sim_event(uint8_t row, uint8_t col, bool pressed);
+
+// A single pass of the main loop (matrix scan, tapping timeouts & RGB), then moving the clock forward by 1ms.
+void sim_tick(void);
+
+///////////////////////////////////////////////////// Hooks /////////////////////////////////////////////////////
+// Implemented by the tool linking against the stand-in.
+
+// A key event coming out of debouncing, i.e., what the rest of the firmware gets to see.
+void sim_on_event(uint8_t row, uint8_t col, bool pressed);
+
+// Every call to process_record_user, with the host time it took.
+void sim_on_record(uint16_t keycode, const keyrecord_t *record, uint64_t elapsed_ns);
+
+// A dual-role key has been decided as either a tap or a hold, with the tapping term in use for it at the time.
+void sim_on_tap_resolved(uint16_t keycode, const keyrecord_t *record, bool hold, uint16_t delay, uint16_t term);
+
+// A report left for the host. Consumer keys (media, brightness, et cetera) are reported with their keycode.
+void sim_on_report(const report_keyboard_t *report);
+void sim_on_consumer(uint8_t keycode, bool pressed);
@@ -0,0 +1,492 @@
+/***************************************************************************************************************\
+* Replay recorded key-event traces against the keymap and report on its latency.                               *
+*                                                                                                               *
+* Copyright 2022  Leandro Emmanuel Reina Kiperman <@kip93>                                                      *
+*                                                                                                               *
+* This program is free software: you can redistribute it and/or modify it under the terms of the GNU General    *
+* Public License as published by the Free Software Foundation, either version 3 of the License, or (at your     *
+* option) any later version.                                                                                    *
+*                                                                                                               *
+* This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the    *
+* implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License   *
+* for more details.                                                                                             *
+*                                                                                                               *
+* You should have received a copy of the GNU General Public License along with this program. If not, see        *
+* <http://www.gnu.org/licenses/>.                                                                               *
+\***************************************************************************************************************/
+
+// Usage: replay [-r] [-n] [-e <eeprom>] <trace>
+//
+// Traces are plain text, one raw matrix change per line, as `<time in ms> <row> <col> <d|u>` (d for key down, u
+// for key up). Times are absolute and must not go backwards. Anything after a `#` is ignored.
+//
+// Presses of dual-role keys can be annotated with what was intended (`t` for a tap, `h` for a hold), as in
+// `<time in ms> <row> <col> d <t|h>`, and then any resolution that went the other way is counted as a misfire.
+//
+// With `-r` the full HID report stream is printed before the summary, one report per line (along with every
+// change of the top layer), which makes it easy to diff the output of two versions of the keymap against the same
+// trace.
+//
+// With `-n` the timings measured on the host are left out (as `-`), so that the output is the same on every run.
+// That's what the expected output of each trace (traces/*.expected) is made with.
+//
+// With `-e` the EEPROM is loaded from the given file (if it exists) before starting, and saved back to it at the
+// end, so that replaying a second trace with the same file is the same as unplugging the keyboard in between.
+
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_EVENTS 65536
+#define TAIL_MS 1000 // Keep running after the last event, so timeouts & animations get to finish.
+
+typedef struct {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+    char     intent; // 't', 'h' or '\0' when unknown.
+} trace_event_t;
+
+static trace_event_t events[MAX_EVENTS];
+static size_t        events_count = 0;
+
+static bool print_reports = false;
+static bool host_times    = true;
+
+static char     intents[MATRIX_ROWS][MATRIX_COLS];
+static uint32_t changes[MATRIX_ROWS][MATRIX_COLS]; // When each key last changed in the trace.
+
+////////////////////////////////////////////////////// Stats ////////////////////////////////////////////////////
+
+typedef struct {
+    uint16_t keycode;
+    uint32_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} record_stats_t;
+
+typedef struct {
+    uint16_t keycode;
+    uint32_t taps;
+    uint32_t holds;
+    uint32_t misfires;
+    uint64_t total_delay;
+    uint16_t max_delay;
+    uint64_t total_term;
+} tap_stats_t;
+
+#define MAX_STATS 64
+
+static record_stats_t record_stats[MAX_STATS];
+static size_t         record_stats_count = 0;
+static tap_stats_t    tap_stats[MAX_STATS];
+static size_t         tap_stats_count = 0;
+
+static uint32_t presses          = 0;
+static uint64_t total_latency    = 0;
+static uint32_t max_latency      = 0;
+static uint32_t keyboard_reports = 0;
+static uint32_t consumer_reports = 0;
+
+// Characters typed, i.e., keys that are new in a report, & bursts of reports no more than BURST_GAP ms apart (only
+// worth reporting when they're at least BURST_MIN characters long, e.g., from a snippet).
+#define BURST_GAP 2
+#define BURST_MIN 10
+
+static uint8_t  last_keys[KEYBOARD_REPORT_KEYS];
+static uint32_t last_report  = 0;
+static uint32_t characters   = 0;
+static uint32_t burst_start  = 0;
+static uint32_t burst_chars  = 0;
+static uint32_t best_chars   = 0;
+static uint32_t best_ms      = 0;
+
+////////////////////////////////////////////////////// Idle /////////////////////////////////////////////////////
+// How far the keyboard wound down while left alone (see idle.h), as seen from the outside.
+
+enum { AWAKE, DIMMED, DARK, RELAXED, IDLE_STATES };
+
+static const char *idle_names[IDLE_STATES] = {"awake", "dimmed", "dark", "relaxed"};
+
+typedef struct {
+    uint32_t ms;
+    uint64_t rgb_ns;
+    uint32_t rgb_writes;
+    uint32_t link_transactions;
+    uint32_t link_bytes;
+} idle_stats_t;
+
+static idle_stats_t idle_stats[IDLE_STATES];
+
+static uint32_t wakes          = 0;
+static uint32_t wake_latency   = 0; // From being pressed to being reported, for the keys that woke it up.
+static bool     waking         = false;
+static uint32_t waking_pressed = 0;
+static uint32_t trace_presses  = 0;
+
+static uint8_t idle_state(void) {
+#ifdef IDLE_SYNC_THROTTLE_AWAKE
+    if (FORCED_SYNC_THROTTLE_MS > IDLE_SYNC_THROTTLE_AWAKE) {
+        return RELAXED;
+    }
+#endif // IDLE_SYNC_THROTTLE_AWAKE
+#ifdef RGB_MATRIX_ENABLE
+    if (!rgb_matrix_config.enable) {
+        return DARK;
+    }
+    if (rgb_matrix_config.hsv.v < RGB_MATRIX_MAXIMUM_BRIGHTNESS) {
+        return DIMMED;
+    }
+#endif // RGB_MATRIX_ENABLE
+    return AWAKE;
+}
+
+void sim_on_event(uint8_t row, uint8_t col, bool pressed) {
+    if (!pressed) {
+        return;
+    }
+
+    if (idle_state() != AWAKE) {
+        ++wakes;
+        waking         = true;
+        waking_pressed = changes[row][col];
+    }
+
+    uint32_t latency = sim_time - changes[row][col];
+    ++presses;
+    total_latency += latency;
+    if (latency > max_latency) {
+        max_latency = latency;
+    }
+}
+
+void sim_on_record(uint16_t keycode, const keyrecord_t *record, uint64_t elapsed_ns) {
+    // Only the custom keycodes get their own entry, everything else is handed over to QMK untouched.
+    uint16_t key = keycode >= SAFE_RANGE ? keycode : 0;
+
+    size_t i = 0;
+    while (i < record_stats_count && record_stats[i].keycode != key) {
+        ++i;
+    }
+    if (i == record_stats_count) {
+        if (record_stats_count == MAX_STATS) {
+            return;
+        }
+        record_stats[record_stats_count++] = (record_stats_t){.keycode = key};
+    }
+
+    record_stats[i].calls += 1;
+    record_stats[i].total_ns += elapsed_ns;
+    if (elapsed_ns > record_stats[i].max_ns) {
+        record_stats[i].max_ns = elapsed_ns;
+    }
+}
+
+void sim_on_tap_resolved(uint16_t keycode, const keyrecord_t *record, bool hold, uint16_t delay, uint16_t term) {
+    size_t i = 0;
+    while (i < tap_stats_count && tap_stats[i].keycode != keycode) {
+        ++i;
+    }
+    if (i == tap_stats_count) {
+        if (tap_stats_count == MAX_STATS) {
+            return;
+        }
+        tap_stats[tap_stats_count++] = (tap_stats_t){.keycode = keycode};
+    }
+
+    hold ? ++tap_stats[i].holds : ++tap_stats[i].taps;
+    char intent = intents[record->event.key.row][record->event.key.col];
+    if (intent && intent != (hold ? 'h' : 't')) {
+        ++tap_stats[i].misfires;
+    }
+    tap_stats[i].total_delay += delay;
+    tap_stats[i].total_term += term;
+    if (delay > tap_stats[i].max_delay) {
+        tap_stats[i].max_delay = delay;
+    }
+}
+
+void sim_on_report(const report_keyboard_t *report) {
+    if (waking) {
+        waking = false;
+        wake_latency += sim_time - waking_pressed;
+    }
+
+    uint32_t typed = 0;
+    for (int i = 0; i < KEYBOARD_REPORT_KEYS; ++i) {
+        bool held = report->keys[i] == KC_NO;
+        for (int j = 0; j < KEYBOARD_REPORT_KEYS && !held; ++j) {
+            held = report->keys[i] == last_keys[j];
+        }
+        typed += !held;
+    }
+    memcpy(last_keys, report->keys, sizeof(last_keys));
+    characters += typed;
+
+    if (keyboard_reports == 0 || sim_time - last_report > BURST_GAP) {
+        burst_start = sim_time;
+        burst_chars = 0;
+    }
+    burst_chars += typed;
+    last_report = sim_time;
+    if (burst_chars > best_chars) {
+        best_chars = burst_chars;
+        best_ms    = sim_time - burst_start + 1;
+    }
+
+    ++keyboard_reports;
+    if (print_reports) {
+        const uint8_t *keys = report->keys;
+        printf("%8u ms  kbd  mods=%02X keys=%02X %02X %02X %02X %02X %02X\n", sim_time, report->mods, keys[0],
+               keys[1], keys[2], keys[3], keys[4], keys[5]);
+    }
+}
+
+void sim_on_consumer(uint8_t keycode, bool pressed) {
+    ++consumer_reports;
+    if (print_reports) {
+        printf("%8u ms  cons key=%02X %s\n", sim_time, keycode, pressed ? "down" : "up");
+    }
+}
+
+///////////////////////////////////////////////////// Report ////////////////////////////////////////////////////
+
+static void print_keycode(uint16_t keycode) {
+    if (keycode >= QK_LAYER_TAP && keycode <= QK_LAYER_TAP_MAX) {
+        printf("LT(%u,0x%02X)        ", (keycode >> 8) & 0xF, keycode & 0xFF);
+    } else if (keycode >= SAFE_RANGE) {
+        printf("SAFE_RANGE + %-5u ", keycode - SAFE_RANGE);
+    } else if (keycode == 0) {
+        printf("(QMK keycodes)     ");
+    } else {
+        printf("0x%04X             ", keycode);
+    }
+}
+
+static void print_summary(const char *path) {
+    printf("Trace:  %s (%zu events, %u ms)\n\n", path, events_count,
+           events_count ? events[events_count - 1].time : 0);
+
+    printf("Debounce: %u presses, %.1f ms mean, %u ms max\n\n", presses,
+           presses ? (double)total_latency / presses : 0.0, max_latency);
+
+    printf("process_record_user (host time)\n");
+    printf("  keycode              calls   mean ns    max ns\n");
+    for (size_t i = 0; i < record_stats_count; ++i) {
+        printf("  ");
+        print_keycode(record_stats[i].keycode);
+        if (host_times) {
+            printf("%7u  %8llu  %8llu\n", record_stats[i].calls,
+                   (unsigned long long)(record_stats[i].total_ns / record_stats[i].calls),
+                   (unsigned long long)record_stats[i].max_ns);
+        } else {
+            printf("%7u  %8s  %8s\n", record_stats[i].calls, "-", "-");
+        }
+    }
+    printf("\n");
+
+    printf("Tap/hold resolution (TAPPING_TERM %u", TAPPING_TERM);
+#ifdef TAPPING_TERM_PER_KEY
+    printf(", TAPPING_TERM_PER_KEY");
+#endif // TAPPING_TERM_PER_KEY
+#ifdef PERMISSIVE_HOLD
+    printf(", PERMISSIVE_HOLD");
+#endif // PERMISSIVE_HOLD
+    printf(")\n");
+    printf("  keycode              taps  holds  misfires  mean ms  max ms  mean term\n");
+    for (size_t i = 0; i < tap_stats_count; ++i) {
+        uint32_t total = tap_stats[i].taps + tap_stats[i].holds;
+        printf("  ");
+        print_keycode(tap_stats[i].keycode);
+        printf("%5u  %5u  %8u  %7.1f  %6u  %9.1f\n", tap_stats[i].taps, tap_stats[i].holds, tap_stats[i].misfires,
+               (double)tap_stats[i].total_delay / total, tap_stats[i].max_delay,
+               (double)tap_stats[i].total_term / total);
+    }
+    printf("\n");
+
+#ifdef RGB_MATRIX_ENABLE
+    printf("RGB matrix: %u frames, %.1f LEDs written per frame, %u flushes\n", rgb_matrix_stats.frames,
+           rgb_matrix_stats.frames ? (double)rgb_matrix_stats.writes / rgb_matrix_stats.frames : 0.0,
+           rgb_matrix_stats.flushes);
+#endif // RGB_MATRIX_ENABLE
+    printf("HID reports: %u keyboard, %u consumer\n", keyboard_reports, consumer_reports);
+    if (best_chars >= BURST_MIN) {
+        printf("Characters typed: %u, longest burst %u in %u ms (%u chars/s)\n", characters, best_chars, best_ms,
+               best_chars * 1000 / best_ms);
+    } else {
+        printf("Characters typed: %u\n", characters);
+    }
+
+    uint32_t eeprom_writes = 0, eeprom_max = 0;
+    for (size_t i = 0; i <= E2END; ++i) {
+        eeprom_writes += sim_eeprom_writes[i];
+        if (sim_eeprom_writes[i] > eeprom_max) {
+            eeprom_max = sim_eeprom_writes[i];
+        }
+    }
+    printf("\n");
+
+    printf("Idle (see idle.h): %u presses in the trace, %u went through, %u woke it up (%.1f ms mean to report)\n",
+           trace_presses, presses, wakes, wakes ? (double)wake_latency / wakes : 0.0);
+    printf("  state        time ms  RGB ns/ms  LEDs/s  link trans/s  link B/s\n");
+    for (uint8_t i = 0; i < IDLE_STATES; ++i) {
+        idle_stats_t *stats = &idle_stats[i];
+        if (stats->ms == 0) {
+            continue;
+        }
+        printf("  %-8s  %10u  ", idle_names[i], stats->ms);
+        if (host_times) {
+            printf("%9llu  ", (unsigned long long)(stats->rgb_ns / stats->ms));
+        } else {
+            printf("%9s  ", "-");
+        }
+        printf("%6.1f  %12.1f  %8.1f\n", 1000.0 * stats->rgb_writes / stats->ms,
+               1000.0 * stats->link_transactions / stats->ms, 1000.0 * stats->link_bytes / stats->ms);
+    }
+    printf("\n");
+
+    printf("EEPROM: %u bytes written, at most %u times to the same one, %u ms waiting for writes\n", eeprom_writes,
+           eeprom_max, sim_eeprom_waits);
+}
+
+////////////////////////////////////////////////////// Main /////////////////////////////////////////////////////
+
+static bool load_trace(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+
+    char     line[256];
+    unsigned number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        ++number;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+
+        unsigned time, row, col;
+        char     state, intent = '\0';
+        int      fields = sscanf(line, "%u %u %u %c %c", &time, &row, &col, &state, &intent);
+        if (fields <= 0) {
+            continue; // Blank line.
+        }
+
+        if (fields < 4 || row >= MATRIX_ROWS || col >= MATRIX_COLS || (state != 'd' && state != 'u') ||
+            (fields == 5 && (state != 'd' || (intent != 't' && intent != 'h'))) ||
+            (events_count && time < events[events_count - 1].time) || events_count == MAX_EVENTS) {
+            fprintf(stderr, "%s:%u: invalid event\n", path, number);
+            fclose(file);
+            return false;
+        }
+
+        events[events_count++] = (trace_event_t){time, row, col, state == 'd', intent};
+    }
+
+    fclose(file);
+    return true;
+}
+
+static void load_eeprom(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file) {
+        if (fread(sim_eeprom, 1, sizeof(sim_eeprom), file) != sizeof(sim_eeprom)) {
+            fprintf(stderr, "%s: short EEPROM image, the rest is left blank\n", path);
+        }
+        fclose(file);
+    }
+}
+
+static bool save_eeprom(const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (!file || fwrite(sim_eeprom, 1, sizeof(sim_eeprom), file) != sizeof(sim_eeprom)) {
+        perror(path);
+        if (file) {
+            fclose(file);
+        }
+        return false;
+    }
+
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *eeprom = NULL;
+
+    int arg = 1;
+    while (arg < argc && argv[arg][0] == '-') {
+        if (strcmp(argv[arg], "-r") == 0) {
+            print_reports = true;
+            ++arg;
+        } else if (strcmp(argv[arg], "-n") == 0) {
+            host_times = false;
+            ++arg;
+        } else if (strcmp(argv[arg], "-e") == 0 && arg + 1 < argc) {
+            eeprom = argv[arg + 1];
+            arg += 2;
+        } else {
+            break;
+        }
+    }
+    if (arg + 1 != argc) {
+        fprintf(stderr, "Usage: %s [-r] [-n] [-e <eeprom>] <trace>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!load_trace(argv[arg])) {
+        return EXIT_FAILURE;
+    }
+    if (eeprom) {
+        load_eeprom(eeprom);
+    }
+
+    sim_init();
+
+    layer_state_t last_layer_state = layer_state;
+
+    size_t   next = 0;
+    uint32_t end  = (events_count ? events[events_count - 1].time : 0) + TAIL_MS;
+    while (sim_time <= end) {
+        while (next < events_count && events[next].time <= sim_time) {
+            if (events[next].pressed) {
+                intents[events[next].row][events[next].col] = events[next].intent;
+                ++trace_presses;
+            }
+            changes[events[next].row][events[next].col] = sim_time;
+            sim_event(events[next].row, events[next].col, events[next].pressed);
+            ++next;
+        }
+        uint8_t           state = idle_state();
+        sim_split_stats_t link  = sim_split_stats;
+#ifdef RGB_MATRIX_ENABLE
+        rgb_matrix_stats_t rgb = rgb_matrix_stats;
+#endif // RGB_MATRIX_ENABLE
+        sim_tick();
+
+        idle_stats[state].ms += 1;
+#ifdef RGB_MATRIX_ENABLE
+        idle_stats[state].rgb_ns += rgb_matrix_stats.task_ns - rgb.task_ns;
+        idle_stats[state].rgb_writes += rgb_matrix_stats.writes - rgb.writes;
+#endif // RGB_MATRIX_ENABLE
+        idle_stats[state].link_transactions += sim_split_stats.transactions - link.transactions;
+        idle_stats[state].link_bytes += sim_split_stats.bytes - link.bytes;
+
+        if (print_reports && layer_state != last_layer_state) {
+            printf("%8u ms  layer %u\n", sim_time - 1, get_highest_layer(layer_state));
+            last_layer_state = layer_state;
+        }
+    }
+
+    if (print_reports) {
+        printf("\n");
+    }
+    print_summary(argv[arg]);
+
+    return !eeprom || save_eeprom(eeprom) ? EXIT_SUCCESS : EXIT_FAILURE;
+}